@@ -0,0 +1,266 @@
+/*******************************************************************************
+* File:        Curve_backend_bench.cpp
+* Description: Compares the AMCL and OpenSSL curve backends
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Tpm_param.h"
+#include "bnp256_param.h"
+#include "Openssl_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Clock_utils.h"
+#include "Curve_backend.h"
+#include "Curve_backend_bench.h"
+
+namespace
+{
+// Times n calls of op, the total in microseconds is added to the result
+template<typename Op>
+void time_stage(Backend_result& br, std::string const& name, size_t n, Op op)
+{
+    F_timer_mu timer;
+    for (size_t i=0;i<n;++i)
+    {
+        op(i);
+    }
+    br.stages.push_back(std::make_pair(name,timer.get_duration()));
+}
+
+// Runs the same stages for either backend
+template<typename C>
+Backend_result run_backend(Bench_inputs const& bi)
+{
+    using G1=typename C::G1;
+    Backend_result br;
+    br.name=C::name();
+    auto const& k=bi.scalars;
+    size_t n=k.size();
+    G1 q(bi.q);
+    typename C::G1_prepared q_prep(q);
+
+    time_stage(br,"generator_mul",n,[&](size_t i){C::generator_mul(k[i]);});
+    time_stage(br,"point_mul",n,[&](size_t i){k[i]*q;});
+    time_stage(br,"prepared_mul",n,[&](size_t i){q_prep.mul(k[i]);});
+    time_stage(br,"multi_mul",n,[&](size_t i){C::multi_mul({k[i],k[n-1-i]},{G1::generator(),q});});
+    time_stage(br,"to_g1_point",n,[&](size_t i){(k[i]*q).to_g1_point();});
+    // As randomise_daa_credential, including the conversions in and out
+    time_stage(br,"randomise",n,[&](size_t i){
+        std::vector<G1> pts;
+        for (auto const& pt : bi.credential)
+        {
+            pts.push_back(typename C::G1_prepared(G1(pt)).mul(k[i]));
+        }
+        C::batch_to_g1_points(pts);
+    });
+    return br;
+}
+
+template<typename C>
+std::vector<G1_point> backend_outputs(Bench_inputs const& bi)
+{
+    using G1=typename C::G1;
+    G1 q(bi.q);
+    auto const& k=bi.scalars;
+    std::vector<G1_point> out;
+    out.push_back(C::generator_mul(k[0]).to_g1_point());
+    out.push_back((k[0]*q).to_g1_point());
+    out.push_back(typename C::G1_prepared(q).mul(k[0]).to_g1_point());
+    out.push_back(C::multi_mul({k[0],k[1]},{G1::generator(),-q}).to_g1_point());
+    return out;
+}
+}
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Null_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    bool bench_ok=false;
+    std::vector<Backend_result> results;
+    try
+    {
+        Random_byte_generator rbg;
+        Bench_inputs bi=make_inputs(pd.iterations,rbg);
+        if (!backends_agree(bi))
+        {
+            std::cerr << "The backends give different results\n";
+        }
+        else
+        {
+            results.push_back(run_backend<Amcl_curve>(bi));
+            results.push_back(run_backend<Openssl_curve>(bi));
+            bench_ok=true;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (!bench_ok)
+    {
+		std::cerr << "Curve backend benchmark failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    write_results(std::cout,pd.iterations,results);
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-n, --number <number of iterations of each stage> - (default 1000)\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    pd.iterations=1000;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        switch (o)
+        {
+        case Option::number:
+            if (arg==argc)
+            {
+                std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+                usage(std::cerr,argv[0]);
+                return Init_result::init_failed;
+            }
+            try
+            {
+                pd.iterations=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid number of iterations: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            if (pd.iterations<2)
+            {
+                std::cerr << "The number of iterations must be at least 2\n";
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        }
+    }
+
+    return Init_result::init_ok;
+}
+
+Bench_inputs make_inputs(size_t iterations, Random_byte_generator& rbg)
+{
+    Bench_inputs bi;
+    size_t random_bytes=bnp256_order.size();
+    for (size_t i=0;i<iterations;++i)
+    {
+        bi.scalars.push_back(bb_mod(rbg(random_bytes),bnp256_order));
+    }
+    bi.q=Amcl_curve::generator_mul(bb_mod(rbg(random_bytes),bnp256_order)).to_g1_point();
+    for (size_t i=0;i<4;++i)
+    {
+        bi.credential.push_back(Amcl_curve::generator_mul(bb_mod(rbg(random_bytes),bnp256_order)).to_g1_point());
+    }
+    return bi;
+}
+
+bool backends_agree(Bench_inputs const& bi)
+{
+    return backend_outputs<Amcl_curve>(bi)==backend_outputs<Openssl_curve>(bi);
+}
+
+void write_results(std::ostream& os, size_t iterations, std::vector<Backend_result> const& results)
+{
+    os << "Operations per second (" << iterations << " iterations)\n";
+    os << std::left << std::setw(16) << "stage";
+    for (auto const& br : results)
+    {
+        os << std::right << std::setw(12) << br.name;
+    }
+    os << '\n';
+    if (results.empty())
+        return;
+
+    for (size_t s=0;s<results[0].stages.size();++s)
+    {
+        os << std::left << std::setw(16) << results[0].stages[s].first;
+        for (auto const& br : results)
+        {
+            os << std::right << std::setw(12) << std::fixed << std::setprecision(0)
+               << iterations*1.0e6/br.stages[s].second;
+        }
+        os << '\n';
+    }
+}
@@ -0,0 +1,95 @@
+/*******************************************************************************
+* File:        Curve_backend_bench.h
+* Description: Compares the AMCL and OpenSSL curve backends
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Get_random_bytes.h"
+
+enum Init_result {init_ok=0,init_failed,init_help};
+
+enum Option {number,help,version};
+
+const std::map<std::string,Option> program_options{
+    {"--number",number},
+    {"-n",number},
+    {"--help",help},
+    {"-h",help},
+    {"--version",version},
+    {"-v",version}
+};
+
+struct Program_data
+{
+    size_t iterations;
+};
+
+// The inputs shared by both backends, so that their results can be compared
+struct Bench_inputs
+{
+    std::vector<Byte_buffer> scalars;   // Random values mod n
+    G1_point q;                         // A point other than P_1
+    std::vector<G1_point> credential;   // Four points, as a DAA credential
+};
+
+// The time taken by each stage for one backend
+struct Backend_result
+{
+    std::string name;
+    std::vector<std::pair<std::string,float>> stages;  // (stage, total microseconds)
+};
+
+void usage(std::ostream& os, const char* name);
+
+Init_result initialise(int argc, char *argv[], Program_data& pd);
+
+Bench_inputs make_inputs(size_t iterations, Random_byte_generator& rbg);
+
+// Checks that both backends give the same encodings for the same operations
+bool backends_agree(Bench_inputs const& bi);
+
+void write_results(std::ostream& os, size_t iterations, std::vector<Backend_result> const& results);
@@ -0,0 +1,300 @@
+/*******************************************************************************
+* File:        Daa_batch_verify.cpp
+* Description: Program to compare batch and individual DAA signature verification
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Tpm_param.h"
+#include "Tpm_defs.h"
+#include "bnp256_param.h"
+#include "Mechanism_4_data.h"
+#include "Openssl_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Openssl_ec_utils.h"
+#include "Openssl_ec_map_to_point.h"
+#include "Clock_utils.h"
+#include "Sha.h"
+#include "G1_utils.h"
+#include "Issuer_public_keys.h"
+#include "Model_hashes.h"
+#include "Amcl_pairings.h"
+#include "Daa_credential.h"
+#include "Verify_daa_batch.h"
+#include "Daa_batch_verify.h"
+
+Tpm_timings tpm_timings;
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Cout_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    Random_byte_generator rbg;
+    Benchmark_result br;
+    try
+    {
+        br=run_benchmark(pd,rbg);
+    }
+    catch(const std::exception& e)
+    {
+        log_ptr->os() << "Exception caught: " << e.what() << std::endl;
+        br=Benchmark_result::benchmark_failed;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (br==Benchmark_result::benchmark_failed)
+    {
+		log_ptr->os() << "Batch verification benchmark failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    tpm_timings.write_tpm_timings(log_ptr->os());
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-g, --debug <debug level> - (0,1,2)\n"
+                    << "\t-n, --number <number of signatures> - (default 100)\n"
+                    << "\t-x, --bad <number of bad signatures> - (default 0)\n"
+                    << "\t-b, --bsn - sign with a basename\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    // Option defaults
+    int debug_level=0;
+    pd.number_of_signatures=100;
+    pd.number_of_bad_signatures=0;
+    pd.use_basename=false;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        if ((o==Option::number || o==Option::bad || o==Option::debug) && arg==argc)
+        {
+            std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        switch (o)
+        {
+        case Option::number:
+            pd.number_of_signatures=std::stoul(argv[arg++]);
+            break;
+        case Option::bad:
+            pd.number_of_bad_signatures=std::stoul(argv[arg++]);
+            break;
+        case Option::usebsn:
+            pd.use_basename=true;
+            break;
+        case Option::debug:
+            {
+                std::string level(argv[arg]);
+                if (level!="0" && level!="1" && level!="2")
+                {
+                    usage(std::cerr,argv[0]);
+                    std::cerr << "Debug levels are 0, 1 or 2 (default 0)\n";
+                    return Init_result::init_failed;            
+                }
+                debug_level=atoi(argv[arg++]);
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        default:
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+    }
+
+    if (pd.number_of_signatures==0 || pd.number_of_bad_signatures>pd.number_of_signatures)
+    {
+        std::cerr << "The number of signatures must be non-zero and at least the number of bad signatures\n";
+        return Init_result::init_failed;
+    }
+
+	log_ptr->set_debug_level(debug_level);
+
+    log_ptr->os() << std::boolalpha << "\nUse basename: " << pd.use_basename
+                  << "\nNumber of signatures: " << pd.number_of_signatures
+                  << "\nNumber of bad signatures: " << pd.number_of_bad_signatures
+                  << "\nDebug level: " << debug_level << std::endl;
+
+    return Init_result::init_ok;
+}
+
+Daa_signature_records make_test_signatures(Program_data const& pd, Random_byte_generator& rbg)
+{
+    Ec_group_ptr const& ecgrp=bnp256_ec_group();
+
+    Byte_buffer daa_sk=bb_mod(rbg(component_size),bnp256_order);
+    G1_point daa_key=ec_generator_mul(ecgrp,daa_sk);
+
+    // The credential is made with the ISO issuer keys, C is then changed for
+    // the bad credential, so e(X,A+D)!=e(P2,C)
+    Daa_credential cre=generate_and_sign_daa_credential(daa_key,rbg).first;
+    Daa_credential bad_cre=cre;
+    bad_cre[2]=ec_point_add(ecgrp,cre[2],cre[0]);
+
+    size_t n=pd.number_of_signatures;
+    size_t n_bad=pd.number_of_bad_signatures;
+    Daa_signature_records recs(n);
+    for (size_t i=0;i<n;++i)
+    {
+        Daa_signature_record& rec=recs[i];
+        // Spread the bad signatures through the set
+        bool bad_sig=((i*n_bad)/n!=((i+1)*n_bad)/n);
+        rec.r_cre=randomise_daa_credential(bad_sig?bad_cre:cre,rbg);
+        rec.msg_digest=sha256_bb(Byte_buffer("Test message "+std::to_string(i)));
+
+        // The calculations done by the TPM in TPM2_Commit and TPM2_Sign
+        Byte_buffer r=bb_mod(rbg(component_size),bnp256_order);
+        G1_point pt_e=ec_point_mul(ecgrp,r,rec.r_cre[1]);
+        G1_point pt_l;
+        while (pd.use_basename && rec.bsn.size()==0)
+        {
+            rec.bsn=rbg(component_size);
+            try
+            {
+                G1_point map_pt=point_from_basename(rec.bsn);
+                rec.pt_j=std::make_pair(bb_mod(sha256_bb(map_pt.first),bnp256_p),map_pt.second);
+            }
+            catch(const std::runtime_error& e)
+            {
+                rec.bsn.clear();   // No point found for this basename, so try again
+                continue;
+            }
+            rec.pt_k=ec_point_mul(ecgrp,daa_sk,rec.pt_j);
+            pt_l=ec_point_mul(ecgrp,r,rec.pt_j);
+        }
+        Byte_buffer c=sign_c(rec.msg_digest,rec.r_cre,rec.pt_j,rec.pt_k,pt_l,pt_e);
+        rec.sig[0]=rbg(component_size);
+        rec.sig[2]=bb_mod(sha256_bb(rec.sig[0]+sha256_bb(c)),bnp256_order);
+        rec.sig[1]=bb_signature_calc(r,rec.sig[2],daa_sk,bnp256_order);
+    }
+
+    return recs;
+}
+
+Benchmark_result run_benchmark(Program_data const& pd, Random_byte_generator& rbg)
+{
+    Daa_signature_records recs=make_test_signatures(pd,rbg);
+    Issuer_public_keys ipk=amcl_calculate_public_keys(std::make_pair(iso_sk_x,iso_sk_y));
+
+    size_t n=recs.size();
+    std::vector<bool> individual_results(n);
+    Tpm_timer tt;
+    for (size_t i=0;i<n;++i)
+    {
+        individual_results[i]=verify_daa_signature_hash(recs[i]) &&
+                              check_daa_pairings(recs[i].r_cre,ipk);
+    }
+    auto individual_dur=tt.get_duration();
+
+    // The issuer's keys only need to be prepared once
+    tt.reset();
+    Prepared_issuer_keys prepared_ipk(ipk);
+    std::vector<bool> prepared_results(n);
+    for (size_t i=0;i<n;++i)
+    {
+        prepared_results[i]=verify_daa_signature_hash(recs[i]) &&
+                            check_daa_pairings(recs[i].r_cre,prepared_ipk);
+    }
+    auto prepared_dur=tt.get_duration();
+
+    tt.reset();
+    std::vector<bool> batch_results=verify_daa_signatures_batch(recs,prepared_ipk,rbg);
+    auto batch_dur=tt.get_duration();
+
+    size_t n_failed=0;
+    for (size_t i=0;i<n;++i)
+    {
+        if (!batch_results[i])
+        {
+            ++n_failed;
+        }
+    }
+
+    tpm_timings.add("Individual verification",individual_dur);
+    tpm_timings.add("Individual verification, prepared keys",prepared_dur);
+    tpm_timings.add("Batch verification",batch_dur);
+
+    log_ptr->os() << "Individual verification: " << n*1.0e6/individual_dur << " signatures/s\n";
+    log_ptr->os() << "Prepared issuer keys:    " << n*1.0e6/prepared_dur << " signatures/s\n";
+    log_ptr->os() << "Batch verification:      " << n*1.0e6/batch_dur << " signatures/s\n";
+    log_ptr->os() << "Signatures failed:       " << n_failed << std::endl;
+
+    if (individual_results!=prepared_results || individual_results!=batch_results || n_failed!=pd.number_of_bad_signatures)
+    {
+        log_ptr->os() << "The verification results differ\n";
+        return Benchmark_result::benchmark_failed;
+    }
+
+    return Benchmark_result::benchmark_ok;
+}
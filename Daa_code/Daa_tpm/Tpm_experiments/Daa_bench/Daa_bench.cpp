@@ -0,0 +1,577 @@
+/*******************************************************************************
+* File:        Daa_bench.cpp
+* Description: End-to-end benchmark of the DAA protocol stages
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "Tss_includes.h"
+#include "Tss_setup.h"
+#include "Tpm_error.h"
+#include "Tpm_daa.h"
+#include "Software_daa.h"
+#include "Tpm_utils.h"
+#include "Tpm_param.h"
+#include "bnp256_param.h"
+#include "Openssl_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Openssl_ec_map_to_point.h"
+#include "Basename_cache.h"
+#include "Sha.h"
+#include "Clock_utils.h"
+#include "Mechanism_4_data.h"
+#include "Model_hashes.h"
+#include "Tpm2_commit.h"
+#include "Daa_credential.h"
+#include "Credential_pool.h"
+#include "Issuer_public_keys.h"
+#include "Verify_daa_batch.h"
+#include "Amcl_pairings.h"
+#include "G1_ecp.h"
+#include "G1_fixed_base.h"
+#include "Daa_bench.h"
+
+// Count the allocations made through operator new. Allocations made directly
+// by OpenSSL and AMCL (malloc or the stack) are not included.
+namespace
+{
+std::atomic<size_t> allocation_count{0};
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocation_count;
+    void* p=std::malloc(size!=0?size:1);
+    if (p==nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+Op_timer::Op_timer(Stage_result& sr) : sr_(sr), start_allocations_(allocation_count.load())
+{
+}
+
+Op_timer::~Op_timer()
+{
+    float t=timer_.get_duration();
+    sr_.allocations+=allocation_count.load()-start_allocations_;
+    sr_.latencies.push_back(t);
+}
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Null_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    Random_byte_generator rbg;
+    Stage_results results;
+    Benchmark_result br;
+    try
+    {
+        br=run_benchmark(pd,rbg,results);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+        br=Benchmark_result::benchmark_failed;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (br==Benchmark_result::benchmark_failed)
+    {
+		std::cerr << "DAA benchmark failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    write_json(std::cout,pd,results);
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-t, --dev - use the TPM device\n\t-s, --sim - use the TPM simulator\n"
+                    << "\t    (with neither, the TPM's calculations are done in software)\n"
+                    << "\t-n, --number <number of iterations of each stage> - (default 100)\n"
+                    << "\t-b, --bsn - sign with a basename\n"
+                    << "\t-g, --debug <debug level> - (0,1,2), logged to daa_bench.log\n"
+                    << "The results are written to stdout as JSON\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    // Used to catch multiple inputs for the device type
+    std::string device="null";
+    // Option defaults
+    int debug_level=0;
+    pd.iterations=100;
+    pd.use_basename=false;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        if ((o==Option::number || o==Option::debug) && arg==argc)
+        {
+            std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        switch (o)
+        {
+        case Option::usedev:
+        case Option::usesim:
+            if (device=="null")
+            {
+                device=(o==Option::usedev)?"T":"S";
+            }
+            else
+            {
+                std::cerr << "Only one interface can be selected\n";
+                usage(std::cerr,argv[0]);
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::number:
+            pd.iterations=std::stoul(argv[arg++]);
+            break;
+        case Option::usebsn:
+            pd.use_basename=true;
+            break;
+        case Option::debug:
+            {
+                std::string level(argv[arg]);
+                if (level!="0" && level!="1" && level!="2")
+                {
+                    usage(std::cerr,argv[0]);
+                    std::cerr << "Debug levels are 0, 1 or 2 (default 0)\n";
+                    return Init_result::init_failed;            
+                }
+                debug_level=atoi(argv[arg++]);
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        default:
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+    }
+
+    if (pd.iterations==0)
+    {
+        std::cerr << "The number of iterations must be non-zero\n";
+        return Init_result::init_failed;
+    }
+
+    if (device=="S") {
+        pd.sp.reset(new Simulator_setup);
+        pd.sp->data_dir.value=Tss_option::sim_data_dir.value;
+        pd.device="simulator";
+    }
+	else if (device=="T") {	// On the Raspberry Pi
+        pd.sp.reset(new Device_setup);
+        pd.sp->data_dir.value=Tss_option::pi_data_dir.value;
+        pd.device="device";
+	}
+	else {
+        pd.device="software";
+	}
+
+    if (debug_level>0)
+    {
+        try
+        {
+            log_ptr.reset(new File_log("daa_bench.log"));
+        }
+        catch (std::runtime_error &e)
+        {
+            std::cerr << e.what() << '\n';
+            return Init_result::init_failed;
+        }
+    }
+	log_ptr->set_debug_level(debug_level);
+
+    log_ptr->os() << "\ndevice: " << pd.device
+                  << "\nNumber of iterations: " << pd.iterations
+                  << std::boolalpha << "\nUse basename: " << pd.use_basename
+                  << "\nDebug level: " << debug_level << std::endl;
+
+    if (pd.sp)
+    {
+        TPM_RC rc=pd.tpm.setup(*pd.sp);
+        if (rc!=0)
+        {
+            std::cerr << "Setting up the TPM returned: " << pd.tpm.get_last_error() << '\n';
+            return Init_result::init_failed;
+        }
+    }
+
+	return Init_result::init_ok;
+}
+
+namespace
+{
+Stage_result make_stage(std::string const& name, size_t n)
+{
+    Stage_result sr;
+    sr.name=name;
+    sr.latencies.reserve(n);
+    sr.allocations=0;
+    return sr;
+}
+
+// Commits for a randomised credential, returning J (if a basename is used)
+// and the commit data
+void commit(Daa_signer& signer, Byte_buffer const& bsn, Daa_credential const& r_cre, G1_point& pt_j, Commit_data& cd)
+{
+    G1_point map_pt;
+    if (bsn.size()!=0)
+    {
+        Basename_points bp=basename_cache().get(bsn);
+        map_pt=bp.map_pt;
+        pt_j=bp.pt_j;
+    }
+    TPM_RC rc=signer.initiate_daa_signature(map_pt.first,map_pt.second,r_cre[1],cd);
+    if (rc!=0)
+    {
+        log_ptr->os() << "initiate_daa_signature returned: " << signer.get_last_error() << std::endl;
+        throw(Tpm_error("initiate_daa_signature failed"));
+    }
+}
+}
+
+Benchmark_result run_benchmark(Program_data& pd, Random_byte_generator& rbg, Stage_results& results)
+{
+    size_t n=pd.iterations;
+
+    Issuer_public_keys ipk=amcl_calculate_public_keys(std::make_pair(iso_sk_x,iso_sk_y));
+
+    // The DAA key is held by the TPM if there is one, otherwise by Software_daa
+    Daa_signer& signer=(pd.sp)?static_cast<Daa_signer&>(pd.tpm):pd.software;
+    if (pd.sp)
+    {
+        TPM_RC rc=pd.tpm.initialise(*pd.sp);
+        if (rc!=0)
+        {
+            std::cerr << "Initialisation of the tpm failed\n";
+            return Benchmark_result::benchmark_failed;
+        }
+    }
+    Byte_buffer daa_pd;
+    TPM_RC rc=signer.create_and_load_daa_key(daa_pd);
+    if (rc!=0)
+    {
+        std::cerr << "create_and_load_daa_key returned: " << signer.get_last_error() << '\n';
+        return Benchmark_result::benchmark_failed;
+    }
+    G1_point daa_key=get_daa_key_from_public_data_bb(daa_pd);
+
+    // Issuer creates and signs a credential for the DAA key
+    Stage_result issue=make_stage("issue",n);
+    std::pair<Daa_credential,Daa_credential_signature> cre_and_sig;
+    for (size_t i=0;i<n;++i)
+    {
+        Op_timer ot(issue);
+        cre_and_sig=generate_and_sign_daa_credential(daa_key,rbg);
+    }
+    Daa_credential const& daa_cre=cre_and_sig.first;
+    if (!check_daa_pairings(daa_cre,ipk))
+    {
+        std::cerr << "The issued credential failed the pairings check\n";
+        return Benchmark_result::benchmark_failed;
+    }
+
+    // Host randomises the credential, once for each signature
+    Stage_result randomise=make_stage("randomise",n);
+    std::vector<Daa_credential> r_cres;
+    r_cres.reserve(n);
+    for (size_t i=0;i<n;++i)
+    {
+        Daa_credential r_cre;
+        {
+            Op_timer ot(randomise);
+            r_cre=randomise_daa_credential(daa_cre,rbg);
+        }
+        r_cres.push_back(std::move(r_cre));
+    }
+
+    // The same from a Credential_pool, given time to refill between takes
+    Stage_result pool_take=make_stage("pool_take",n);
+    {
+        Credential_pool cre_pool(daa_cre);
+        for (size_t i=0;i<n;++i)
+        {
+            cre_pool.wait_until_full();
+            Op_timer ot(pool_take);
+            cre_pool.take(rbg);
+        }
+    }
+
+    Stage_result commit_stage=make_stage("commit",n);
+    Stage_result sign=make_stage("sign",n);
+    Stage_result certify=make_stage("certify",n);
+    Stage_result quote=make_stage("quote",n);
+    Stage_result verify=make_stage("verify",n);
+    Stage_result pairings=make_stage("pairings",n);
+
+    Byte_buffer bsn;
+    if (pd.use_basename)
+    {
+        bsn=Byte_buffer(std::string("daa_bench basename"));
+    }
+    Byte_buffer msg_digest=sha256_bb(Byte_buffer(std::string("This is a test message for now")));
+
+    // Host commits and signs a message, the TPM completes the signature
+    Daa_signature_records recs;
+    recs.reserve(n);
+    for (size_t i=0;i<n;++i)
+    {
+        Daa_signature_record rec;
+        rec.msg_digest=msg_digest;
+        rec.bsn=bsn;
+        rec.r_cre=r_cres[i];
+        Commit_data cd;
+        {
+            Op_timer ot(commit_stage);
+            commit(signer,bsn,rec.r_cre,rec.pt_j,cd);
+        }
+        {
+            Op_timer ot(sign);
+            Commit_points const& pts=cd.second;
+            Byte_buffer c=sign_c(msg_digest,rec.r_cre,rec.pt_j,pts[0],pts[1],pts[2]);
+            rc=signer.complete_daa_signature(cd.first,c,rec.sig[0],rec.sig[1]);
+            rec.sig[2]=bb_mod(sha256_bb(rec.sig[0]+sha256_bb(c)),bnp256_order);
+        }
+        if (rc!=0)
+        {
+            std::cerr << "complete_daa_signature returned: " << signer.get_last_error() << '\n';
+            return Benchmark_result::benchmark_failed;
+        }
+        if (bsn.size()!=0)
+        {
+            rec.pt_k=cd.second[0];
+        }
+        recs.push_back(std::move(rec));
+    }
+
+    // Host certifies a pseudonym key
+    Byte_buffer qps_pd;
+    int qps_id=0;
+    rc=signer.create_and_load_pseudonym_key(qps_id,qps_pd);
+    if (rc!=0)
+    {
+        std::cerr << "create_and_load_pseudonym_key returned: " << signer.get_last_error() << '\n';
+        return Benchmark_result::benchmark_failed;
+    }
+    Byte_buffer cert_label("credential data");
+    for (size_t i=0;i<n;++i)
+    {
+        G1_point pt_j;
+        Commit_data cd;
+        commit(signer,bsn,r_cres[i],pt_j,cd);
+        Byte_buffer cert;
+        Byte_buffer nt;
+        Byte_buffer sig_s;
+        {
+            Op_timer ot(certify);
+            Commit_points const& pts=cd.second;
+            Byte_buffer c=sign_c(cert_label,r_cres[i],pt_j,pts[0],pts[1],pts[2]);
+            rc=signer.certify_and_sign(qps_id,cd.first,c,cert,nt,sig_s);
+        }
+        if (rc!=0)
+        {
+            std::cerr << "certify_and_sign returned: " << signer.get_last_error() << '\n';
+            return Benchmark_result::benchmark_failed;
+        }
+    }
+
+    // Host quotes the application PCR
+    TPML_PCR_SELECTION pcr_sel;
+    pcr_sel.count=1;
+    pcr_sel.pcrSelections[0].hash=TPM_ALG_SHA256;
+    pcr_sel.pcrSelections[0].sizeofSelect=3; // Minimum size
+    pcr_sel.pcrSelections[0].pcrSelect[0]=0;
+    pcr_sel.pcrSelections[0].pcrSelect[1]=0;
+    pcr_sel.pcrSelections[0].pcrSelect[2]=0;
+    pcr_sel.pcrSelections[0].pcrSelect[app_pcr_handle / 8] = 1 << (app_pcr_handle % 8);
+    Byte_buffer pcr_label("pcr data");
+    for (size_t i=0;i<n;++i)
+    {
+        G1_point pt_j;
+        Commit_data cd;
+        commit(signer,bsn,r_cres[i],pt_j,cd);
+        Byte_buffer a_pcr;
+        Byte_buffer nt;
+        Byte_buffer sig_s;
+        {
+            Op_timer ot(quote);
+            Commit_points const& pts=cd.second;
+            Byte_buffer c=sign_c(pcr_label,r_cres[i],pt_j,pts[0],pts[1],pts[2]);
+            rc=signer.quote_and_sign(pcr_sel,cd.first,c,a_pcr,nt,sig_s);
+        }
+        if (rc!=0)
+        {
+            std::cerr << "quote_and_sign returned: " << signer.get_last_error() << '\n';
+            return Benchmark_result::benchmark_failed;
+        }
+    }
+
+    // Verifier checks the signature hash (the pairings are done below)
+    for (auto const& rec : recs)
+    {
+        bool sig_ok;
+        {
+            Op_timer ot(verify);
+            sig_ok=verify_daa_signature_hash(rec);
+        }
+        if (!sig_ok)
+        {
+            std::cerr << "A signature failed to verify\n";
+            return Benchmark_result::benchmark_failed;
+        }
+    }
+
+    // Verifier checks the pairings for each randomised credential
+    for (auto const& r_cre : r_cres)
+    {
+        bool pairings_ok;
+        {
+            Op_timer ot(pairings);
+            pairings_ok=check_daa_pairings(r_cre,ipk);
+        }
+        if (!pairings_ok)
+        {
+            std::cerr << "A randomised credential failed the pairings check\n";
+            return Benchmark_result::benchmark_failed;
+        }
+    }
+
+    results.push_back(std::move(issue));
+    results.push_back(std::move(randomise));
+    results.push_back(std::move(pool_take));
+    results.push_back(std::move(commit_stage));
+    results.push_back(std::move(sign));
+    results.push_back(std::move(certify));
+    results.push_back(std::move(quote));
+    results.push_back(std::move(verify));
+    results.push_back(std::move(pairings));
+
+    return Benchmark_result::benchmark_ok;
+}
+
+namespace
+{
+// Nearest rank percentile of a sorted set of latencies
+float percentile(std::vector<float> const& sorted, double p)
+{
+    size_t rank=static_cast<size_t>(std::ceil(p*sorted.size()));
+    return sorted[std::max<size_t>(rank,1)-1];
+}
+}
+
+void write_json(std::ostream& os, Program_data const& pd, Stage_results const& results)
+{
+    os << "{\n\t\"program\": \"daa_bench\",\n\t\"version\": \"" << code_version
+       << "\",\n\t\"device\": \"" << pd.device
+       << "\",\n\t\"iterations\": " << pd.iterations
+       << ",\n\t\"use_basename\": " << std::boolalpha << pd.use_basename
+       << ",\n\t\"stages\": [";
+    for (size_t i=0;i<results.size();++i)
+    {
+        Stage_result const& sr=results[i];
+        std::vector<float> sorted=sr.latencies;
+        std::sort(sorted.begin(),sorted.end());
+        double total=0.0;
+        for (auto t : sorted)
+        {
+            total+=t;
+        }
+        size_t ops=sorted.size();
+        os << ((i==0)?"\n":",\n") << "\t\t{\"name\": \"" << sr.name
+           << "\", \"operations\": " << ops
+           << ", \"ops_per_sec\": " << ops*1.0e6/total
+           << ", \"p50_us\": " << percentile(sorted,0.5)
+           << ", \"p99_us\": " << percentile(sorted,0.99)
+           << ", \"allocs_per_op\": " << static_cast<double>(sr.allocations)/ops << "}";
+    }
+    os << "\n\t]\n}\n";
+}
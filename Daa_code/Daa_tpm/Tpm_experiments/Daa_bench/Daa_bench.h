@@ -0,0 +1,119 @@
+/*******************************************************************************
+* File:        Daa_bench.h
+* Description: Definitions for the end-to-end DAA benchmark
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "Tss_setup.h"
+#include "Tpm_error.h"
+#include "Tpm_daa.h"
+#include "Software_daa.h"
+#include "Tpm_utils.h"
+#include "Get_random_bytes.h"
+#include "Clock_utils.h"
+
+enum Init_result {init_ok=0,init_failed,init_help};
+
+enum Option {usedev,usesim,number,usebsn,help,version,debug};
+
+const std::map<std::string,Option> program_options{
+    {"--dev",usedev},
+    {"-t",usedev},
+    {"--sim",usesim},
+    {"-s",usesim},
+    {"--number",number},
+    {"-n",number},
+    {"--bsn",usebsn},
+    {"-b",usebsn},
+    {"--debug", debug},
+    {"-g", debug},
+    {"--help",help},
+    {"-h",help},
+    {"--version",version},
+    {"-v",version}
+};
+
+struct Program_data
+{
+    Tpm_daa tpm;
+    Software_daa software;  // Used if no TPM is selected
+    Setup_ptr sp;           // Not set if no TPM is used
+    std::string device;
+    size_t iterations;
+    bool use_basename;
+};
+
+// The measurements for one stage of the protocol
+struct Stage_result
+{
+    std::string name;
+    std::vector<float> latencies;   // microseconds, one per operation
+    size_t allocations;             // operator new calls over all operations
+};
+
+using Stage_results=std::vector<Stage_result>;
+
+// Times a single operation and adds it to a stage. The allocation count is
+// the number of calls to operator new made while the timer is in scope.
+class Op_timer
+{
+public:
+    explicit Op_timer(Stage_result& sr);
+    ~Op_timer();
+private:
+    Stage_result& sr_;
+    size_t start_allocations_;
+    F_timer_mu timer_;
+};
+
+void usage(std::ostream& os, const char* name);
+
+Init_result initialise(int argc, char *argv[], Program_data& pd);
+
+enum Benchmark_result {benchmark_ok,benchmark_failed};
+
+// Runs each stage in turn, using the TPM if one is selected, otherwise Software_daa
+Benchmark_result run_benchmark(Program_data& pd, Random_byte_generator& rbg, Stage_results& results);
+
+void write_json(std::ostream& os, Program_data const& pd, Stage_results const& results);
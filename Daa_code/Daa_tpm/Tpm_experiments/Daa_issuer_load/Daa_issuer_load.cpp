@@ -0,0 +1,304 @@
+/*******************************************************************************
+* File:        Daa_issuer_load.cpp
+* Description: Load generator for the multi-threaded issuer
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include "Tss_includes.h"
+#include "Tss_setup.h"
+#include "Tpm_error.h"
+#include "Tpm_daa.h"
+#include "Tpm_utils.h"
+#include "Tpm_param.h"
+#include "Openssl_utils.h"
+#include "Clock_utils.h"
+#include "Make_credential.h"
+#include "Credential_issuer.h"
+#include "Issuer_engine.h"
+#include "Daa_issuer_load.h"
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Cout_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    Benchmark_result br;
+    try
+    {
+        br=run_benchmark(pd);
+    }
+    catch(const std::exception& e)
+    {
+        log_ptr->os() << "Exception caught: " << e.what() << std::endl;
+        br=Benchmark_result::benchmark_failed;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (br==Benchmark_result::benchmark_failed)
+    {
+		log_ptr->os() << "Issuer load test failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    tpm_timings.write_tpm_timings(log_ptr->os());
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-t, --dev - use the TPM device\n\t-s, --sim - use the TPM simulator\n"
+                    << "\t-g, --debug <debug level> - (0,1,2)\n"
+                    << "\t-n, --number <number of joins> - (default 200)\n"
+                    << "\t-j, --threads <maximum number of threads> - (default, the number of cores)\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    // Used to catch multiple inputs for the device type
+    std::string device="null";
+    // Option defaults
+    int debug_level=0;
+    pd.number_of_joins=200;
+    pd.max_threads=std::max(1U,std::thread::hardware_concurrency());
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        if ((o==Option::number || o==Option::threads || o==Option::debug) && arg==argc)
+        {
+            std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        switch (o)
+        {
+        case Option::usedev:
+        case Option::usesim:
+            if (device=="null")
+            {
+                device=(o==Option::usedev)?"T":"S";
+            }
+            else
+            {
+                std::cerr << "Only one interface can be selected\n";
+                usage(std::cerr,argv[0]);
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::number:
+            pd.number_of_joins=std::stoul(argv[arg++]);
+            break;
+        case Option::threads:
+            pd.max_threads=std::stoul(argv[arg++]);
+            break;
+        case Option::debug:
+            {
+                std::string level(argv[arg]);
+                if (level!="0" && level!="1" && level!="2")
+                {
+                    usage(std::cerr,argv[0]);
+                    std::cerr << "Debug levels are 0, 1 or 2 (default 0)\n";
+                    return Init_result::init_failed;            
+                }
+                debug_level=atoi(argv[arg++]);
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        default:
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+    }
+
+    if (pd.number_of_joins==0 || pd.max_threads==0)
+    {
+        std::cerr << "The number of joins and the number of threads must be non-zero\n";
+        return Init_result::init_failed;
+    }
+
+    if (device=="S") {
+        pd.sp.reset(new Simulator_setup);
+        pd.sp->data_dir.value=Tss_option::sim_data_dir.value;
+    }
+	else if (device=="T") {	// On the Raspberry Pi
+        pd.sp.reset(new Device_setup);
+        pd.sp->data_dir.value=Tss_option::pi_data_dir.value;
+	}
+	else {
+		std::cerr << "A device must be selected\n";
+        usage(std::cerr,argv[0]);
+		return Init_result::init_failed;
+	}
+
+	log_ptr->set_debug_level(debug_level);
+
+    log_ptr->os() << "\ndevice: " << device
+                  << "\nNumber of joins: " << pd.number_of_joins
+                  << "\nMaximum number of threads: " << pd.max_threads
+                  << "\nDebug level: " << debug_level << std::endl;
+
+    TPM_RC rc=pd.tpm.setup(*pd.sp);
+	if (rc!=0)
+	{
+		log_ptr->os() << "Setting up the TPM returned: " << pd.tpm.get_last_error() << '\n';
+		return Init_result::init_failed;
+	}
+
+	Byte_buffer ek_pd;
+	rc=pd.tpm.get_endorsement_key_data(ek_pd);
+	if (rc!=0)
+	{
+		std::cerr << "get_endorsement_key_data returned: " << pd.tpm.get_last_error() << '\n';
+		return Init_result::init_failed;
+	}	
+
+	pd.ek_bb=get_ek_from_public_data_bb(ek_pd);
+	if (pd.ek_bb.size()==0)
+	{
+        std::cerr << "Unable to extract the endorsement key from the public data\n";
+		return Init_result::init_failed;
+	}
+
+	return Init_result::init_ok;
+}
+
+Benchmark_result run_benchmark(Program_data& pd)
+{
+    TPM_RC rc=pd.tpm.initialise(*pd.sp);
+    if (rc!=0)
+    {
+        std::cerr << "Initialisation of the tpm failed\n";
+        return Benchmark_result::benchmark_failed;
+    }
+
+	Byte_buffer daa_pd;
+	rc=pd.tpm.create_and_load_daa_key(daa_pd);
+	if (rc!=0)
+	{
+		std::cerr << "create_and_load_daa_key returned: " << pd.tpm.get_last_error() << '\n';
+		return Benchmark_result::benchmark_failed;
+	}	
+
+    size_t n=pd.number_of_joins;
+
+    // The single applicant issuer, one join after another
+	Credential_issuer issuer;
+	issuer.set_ek_public_key(pd.ek_bb);
+    rc=issuer.set_daa_public_data(daa_pd);
+	if (rc!=0)
+	{
+		std::cerr << "Unmarshalling the daa_key_data failed." << '\n';
+		return Benchmark_result::benchmark_failed;
+	}
+    Tpm_timer tt;
+    for (size_t i=0;i<n;++i)
+    {
+        issuer.make_full_credential();
+    }
+    auto dur=tt.get_duration();
+    tpm_timings.add("Credential_issuer",dur);
+    log_ptr->os() << "Credential_issuer, 1 thread: " << n*1.0e6/dur << " joins/s\n";
+
+    std::vector<size_t> thread_counts;
+    for (size_t t=1;t<pd.max_threads;t*=2)
+    {
+        thread_counts.push_back(t);
+    }
+    thread_counts.push_back(pd.max_threads);
+
+    for (auto t : thread_counts)
+    {
+        Issuer_engine engine(t);
+        std::vector<std::future<Issuer_engine::Join_result>> joins;
+        joins.reserve(n);
+        tt.reset();
+        for (size_t i=0;i<n;++i)
+        {
+            joins.push_back(engine.submit_join(pd.ek_bb,daa_pd));
+        }
+        for (auto& j : joins)
+        {
+            auto result=j.get();
+            if (result.second.size()==0)
+            {
+                log_ptr->os() << "Issuer_engine: a join returned no credential\n";
+                return Benchmark_result::benchmark_failed;
+            }
+        }
+        dur=tt.get_duration();
+        tpm_timings.add("Issuer_engine, "+std::to_string(t)+" threads",dur);
+        log_ptr->os() << "Issuer_engine, " << t << " threads: " << n*1.0e6/dur << " joins/s\n";
+    }
+
+    return Benchmark_result::benchmark_ok;
+}
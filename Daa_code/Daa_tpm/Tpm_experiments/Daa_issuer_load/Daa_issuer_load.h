@@ -0,0 +1,89 @@
+/*******************************************************************************
+* File:        Daa_issuer_load.h
+* Description: Load generator for the multi-threaded issuer
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include "Tss_setup.h"
+#include "Tpm_error.h"
+#include "Tpm_daa.h"
+#include "Tpm_utils.h"
+
+enum Init_result {init_ok=0,init_failed,init_help};
+
+enum Option {usedev,usesim,number,threads,help,version,debug};
+
+const std::map<std::string,Option> program_options{
+    {"--dev",usedev},
+    {"-t",usedev},
+    {"--sim",usesim},
+    {"-s",usesim},
+    {"--number",number},
+    {"-n",number},
+    {"--threads",threads},
+    {"-j",threads},
+    {"--debug", debug},
+    {"-g", debug},
+    {"--help",help},
+    {"-h",help},
+    {"--version",version},
+    {"-v",version}
+};
+
+struct Program_data
+{
+    Tpm_daa tpm;
+    Byte_buffer ek_bb;
+    Setup_ptr sp;
+    size_t number_of_joins;
+    size_t max_threads;
+};
+
+void usage(std::ostream& os, const char* name);
+
+Init_result initialise(int argc, char *argv[], Program_data& pd);
+
+enum Benchmark_result {benchmark_ok,benchmark_failed};
+
+// The TPM provides one applicant's keys, which are then used for every join
+Benchmark_result run_benchmark(Program_data& pd);
@@ -68,7 +68,9 @@
 #include "Tpm2_commit.h"
 #include "Daa_certify.h"
 #include "Daa_credential.h"
+#include "Credential_pool.h"
 #include "Openssl_ec_map_to_point.h"
+#include "Basename_cache.h"
 #include "Tpm_param.h"
 #include "Daa_signatures.h"
 
@@ -180,6 +182,10 @@ Protocol_result run_protocol(Program_data& pd, Random_byte_generator& rbg)
 
     auto daa_cre=deserialise_daa_credential(serialised_cre);
 
+    // The randomised credential is made in the background while the TPM
+    // loads the key, this only quotes once so one is enough
+    Credential_pool cre_pool(daa_cre,1,Pool_refill::once);
+
     rc=pd.tpm.install_and_load_key("daa","ek",daa_kd);
     if (rc!=0)
     {
@@ -189,7 +195,13 @@ Protocol_result run_protocol(Program_data& pd, Random_byte_generator& rbg)
 
     Tpm_timer tt;
     // Prepare to use the DAA key
-    Daa_credential r_cre=randomise_daa_credential(daa_cre,rbg);
+    Daa_credential r_cre=cre_pool.take(rbg);
+    if (log_ptr->debug_level()>0)
+    {
+        auto m=cre_pool.metrics();
+        log_ptr->os() << "Credential pool: depth " << m.depth << " of " << m.capacity << ", " << m.misses
+                      << " misses, refill rate " << m.refill_per_sec << " per second" << std::endl;
+    }
  
     Byte_buffer bsn;
     if (pd.use_basename)
@@ -205,8 +217,9 @@ Protocol_result run_protocol(Program_data& pd, Random_byte_generator& rbg)
     G1_point pt_j;
     if (bsn.size()!=0)
     {
-        map_pt=point_from_basename(bsn);
-        pt_j=std::make_pair(bb_mod(sha256_bb(map_pt.first),bnp256_p),map_pt.second);
+        Basename_points bp=basename_cache().get(bsn);
+        map_pt=bp.map_pt;
+        pt_j=bp.pt_j;
         log_ptr->os() << bsn << std::endl;
     }
     else
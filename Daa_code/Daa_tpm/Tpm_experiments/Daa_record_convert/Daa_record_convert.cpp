@@ -0,0 +1,319 @@
+/*******************************************************************************
+* File:        Daa_record_convert.cpp
+* Description: Converts DAA records between the text and binary formats
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "Tpm_param.h"
+#include "Openssl_utils.h"
+#include "Byte_buffer.h"
+#include "Clock_utils.h"
+#include "Logging.h"
+#include "Issuer_public_keys.h"
+#include "Daa_credential.h"
+#include "Daa_records.h"
+#include "Daa_wire_format.h"
+#include "Daa_record_convert.h"
+
+namespace
+{
+Byte_buffer read_hex_line(std::string const& text)
+{
+    std::istringstream is(text);
+    Byte_buffer bb;
+    is >> bb;
+    return bb;
+}
+
+Byte_buffer text_to_wire(std::string const& text, Program_data const& pd)
+{
+    switch (pd.kind)
+    {
+    case Text_kind::keys:
+        return wire_encode_issuer_public_keys(deserialise_issuer_public_keys(read_hex_line(text)));
+    case Text_kind::credential:
+        return wire_encode_daa_credential(deserialise_daa_credential(read_hex_line(text)));
+    default:
+        break;
+    }
+    std::istringstream is(text);
+    return daa_text_record_to_wire(is,pd.use_basename);
+}
+
+// Reads the record as far as the structures that are verified, returning
+// their number so that the compiler cannot drop the reads
+size_t read_text(std::string const& text, Daa_wire_type type, bool use_basename)
+{
+    std::istringstream is(text);
+    Byte_buffer serialised_ipk;
+    switch (type)
+    {
+    case Daa_wire_type::issuer_public_keys:
+        return deserialise_issuer_public_keys(read_hex_line(text)).first.first.first.size();
+    case Daa_wire_type::credential:
+        return deserialise_daa_credential(read_hex_line(text)).size();
+    case Daa_wire_type::sign:
+        return read_daa_signature_record(is,use_basename,serialised_ipk).sig.size()+
+               deserialise_issuer_public_keys(serialised_ipk).first.first.first.size();
+    default:
+        return read_daa_attestation_record(is,use_basename,serialised_ipk).cert.size()+
+               deserialise_issuer_public_keys(serialised_ipk).first.first.first.size();
+    }
+}
+
+size_t read_wire(std::string const& wire)
+{
+    Daa_wire_record rec=parse_daa_wire_record(reinterpret_cast<Byte_const_ptr>(wire.data()),wire.size());
+    switch (rec.type)
+    {
+    case Daa_wire_type::issuer_public_keys:
+        return wire_issuer_public_keys(rec.issuer_keys).first.first.first.size();
+    case Daa_wire_type::credential:
+        return wire_daa_credential(rec.credential).size();
+    case Daa_wire_type::sign:
+        return wire_to_signature_record(rec).sig.size()+
+               wire_issuer_public_keys(rec.issuer_keys).first.first.first.size();
+    default:
+        return wire_to_attestation_record(rec).cert.size()+
+               wire_issuer_public_keys(rec.issuer_keys).first.first.first.size();
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Null_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    bool convert_ok=false;
+    try
+    {
+        std::string in=read_file(pd.input_file);
+        std::string out;
+        std::string text;
+        std::string wire;
+        if (pd.to_text)
+        {
+            std::ostringstream os;
+            Daa_wire_record rec=parse_daa_wire_record(reinterpret_cast<Byte_const_ptr>(in.data()),in.size());
+            daa_wire_record_to_text(os,rec);
+            out=os.str();
+            pd.use_basename=rec.use_basename;
+            text=out;
+            wire=in;
+        }
+        else
+        {
+            out=bb_to_string(text_to_wire(in,pd));
+            text=in;
+            wire=out;
+        }
+        write_file(pd.output_file,out);
+        if (pd.repeat!=0)
+        {
+            time_reads(std::cout,text,wire,pd);
+        }
+        convert_ok=true;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (!convert_ok)
+    {
+		std::cerr << "Record conversion failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-i, --input <file to convert>\n"
+                    << "\t-o, --output <file to write>\n"
+                    << "\t-t, --to-text - convert a binary record to text (default, text to binary)\n"
+                    << "\t-b, --basename - the text record uses a basename\n"
+                    << "\t-k, --keys - the text is the issuer's public keys\n"
+                    << "\t-c, --credential - the text is a credential\n"
+                    << "\t-n, --repeat <number> - time reading the record in each format\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    pd.use_basename=false;
+    pd.to_text=false;
+    pd.kind=Text_kind::record;
+    pd.repeat=0;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        if ((o==Option::input || o==Option::output || o==Option::repeat) && arg==argc)
+        {
+            std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        switch (o)
+        {
+        case Option::input:
+            pd.input_file=argv[arg++];
+            break;
+        case Option::output:
+            pd.output_file=argv[arg++];
+            break;
+        case Option::use_bsn:
+            pd.use_basename=true;
+            break;
+        case Option::to_text:
+            pd.to_text=true;
+            break;
+        case Option::keys:
+            pd.kind=Text_kind::keys;
+            break;
+        case Option::credential:
+            pd.kind=Text_kind::credential;
+            break;
+        case Option::repeat:
+            try
+            {
+                pd.repeat=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid number of repeats: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        }
+    }
+
+    if (pd.input_file.empty() || pd.output_file.empty())
+    {
+        std::cerr << "Both the input and output files must be given\n";
+        usage(std::cerr,argv[0]);
+        return Init_result::init_failed;
+    }
+
+    return Init_result::init_ok;
+}
+
+std::string read_file(std::string const& filename)
+{
+    std::ifstream is(filename.c_str(),std::ios::binary);
+    if (!is)
+    {
+        throw(std::runtime_error("Unable to open the input file: "+filename));
+    }
+    std::ostringstream contents;
+    contents << is.rdbuf();
+    return contents.str();
+}
+
+void write_file(std::string const& filename, std::string const& contents)
+{
+    std::ofstream os(filename.c_str(),std::ios::binary);
+    if (!os)
+    {
+        throw(std::runtime_error("Unable to open the output file: "+filename));
+    }
+    os << contents;
+}
+
+void time_reads(std::ostream& os, std::string const& text, std::string const& wire, Program_data const& pd)
+{
+    Daa_wire_type type=parse_daa_wire_record(reinterpret_cast<Byte_const_ptr>(wire.data()),wire.size()).type;
+    size_t check=0;
+    F_timer_mu ft;
+    for (size_t i=0;i<pd.repeat;++i)
+    {
+        check+=read_text(text,type,pd.use_basename);
+    }
+    float text_time=ft.get_duration();
+    ft.reset();
+    for (size_t i=0;i<pd.repeat;++i)
+    {
+        check+=read_wire(wire);
+    }
+    float wire_time=ft.get_duration();
+
+    os << "Microseconds per read (" << text.size() << " bytes as text, " << wire.size() << " bytes binary)\n";
+    os << std::fixed << std::setprecision(2) << "text:   " << text_time/pd.repeat << '\n';
+    os << "binary: " << wire_time/pd.repeat << '\n';
+    if (check==0)
+    {
+        os << "(nothing read)\n";
+    }
+}
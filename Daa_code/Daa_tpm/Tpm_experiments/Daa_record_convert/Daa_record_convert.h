@@ -0,0 +1,94 @@
+/*******************************************************************************
+* File:        Daa_record_convert.h
+* Description: Converts DAA records between the text and binary formats
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+
+enum Init_result {init_ok=0,init_failed,init_help};
+
+enum Option {input,output,use_bsn,to_text,keys,credential,repeat,help,version};
+
+const std::map<std::string,Option> program_options{
+    {"--input",input},
+    {"-i",input},
+    {"--output",output},
+    {"-o",output},
+    {"--basename",use_bsn},
+    {"-b",use_bsn},
+    {"--to-text",to_text},
+    {"-t",to_text},
+    {"--keys",keys},
+    {"-k",keys},
+    {"--credential",credential},
+    {"-c",credential},
+    {"--repeat",repeat},
+    {"-n",repeat},
+    {"--help",help},
+    {"-h",help},
+    {"--version",version},
+    {"-v",version}
+};
+
+// The kind of text record, a binary record says what it is
+enum class Text_kind {record,keys,credential};
+
+struct Program_data
+{
+    std::string input_file;
+    std::string output_file;
+    bool use_basename;
+    bool to_text;
+    Text_kind kind;
+    size_t repeat;      // 0, do not time the reads
+};
+
+void usage(std::ostream& os, const char* name);
+
+Init_result initialise(int argc, char *argv[], Program_data& pd);
+
+std::string read_file(std::string const& filename);
+
+void write_file(std::string const& filename, std::string const& contents);
+
+// Times reading the record in each format, as far as the verifiers' records
+void time_reads(std::ostream& os, std::string const& text, std::string const& wire, Program_data const& pd);
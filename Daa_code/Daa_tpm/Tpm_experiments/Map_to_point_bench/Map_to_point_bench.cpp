@@ -0,0 +1,229 @@
+/*******************************************************************************
+* File:        Map_to_point_bench.cpp
+* Description: Compares the OpenSSL and fixed-width map_to_point implementations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Tpm_param.h"
+#include "Openssl_utils.h"
+#include "Openssl_bnp256.h"
+#include "Openssl_ec_map_to_point.h"
+#include "Bnp256_map_to_point.h"
+#include "Clock_utils.h"
+#include "Logging.h"
+#include "Map_to_point_bench.h"
+
+namespace
+{
+// Enough tries that a random basename will not fail to map (2^-64)
+const uint32_t bench_max_iter=64;
+
+const size_t basename_size=32;
+
+template<typename Op>
+Map_result time_map(std::string const& name, Op op)
+{
+    F_timer_mu timer;
+    op();
+    return Map_result{name,timer.get_duration()};
+}
+}
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Null_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    bool bench_ok=false;
+    std::vector<Map_result> results;
+    try
+    {
+        Random_byte_generator rbg;
+        auto basenames=make_basenames(pd.iterations,rbg);
+        if (!implementations_agree(basenames))
+        {
+            std::cerr << "The map_to_point implementations give different results\n";
+        }
+        else
+        {
+            Ec_group_ptr const& ecgrp=bnp256_ec_group();
+            results.push_back(time_map("openssl",[&](){
+                for (auto const& bsn : basenames)
+                {
+                    map_to_point(ecgrp,bsn,bench_max_iter);
+                }
+            }));
+            results.push_back(time_map("fixed_width",[&](){
+                for (auto const& bsn : basenames)
+                {
+                    bnp256_map_to_point(bsn,bench_max_iter);
+                }
+            }));
+            results.push_back(time_map("batch",[&](){
+                bnp256_map_to_points(basenames,bench_max_iter);
+            }));
+            bench_ok=true;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (!bench_ok)
+    {
+		std::cerr << "Map to point benchmark failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    write_results(std::cout,pd.iterations,results);
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-n, --number <number of basenames to map> - (default 1000)\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    pd.iterations=1000;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        switch (o)
+        {
+        case Option::number:
+            if (arg==argc)
+            {
+                std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+                usage(std::cerr,argv[0]);
+                return Init_result::init_failed;
+            }
+            try
+            {
+                pd.iterations=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid number of basenames: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            if (pd.iterations<1)
+            {
+                std::cerr << "The number of basenames must be at least 1\n";
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        }
+    }
+
+    return Init_result::init_ok;
+}
+
+std::vector<Byte_buffer> make_basenames(size_t iterations, Random_byte_generator& rbg)
+{
+    std::vector<Byte_buffer> basenames;
+    for (size_t i=0;i<iterations;++i)
+    {
+        basenames.push_back(rbg(basename_size));
+    }
+    return basenames;
+}
+
+bool implementations_agree(std::vector<Byte_buffer> const& basenames)
+{
+    Ec_group_ptr const& ecgrp=bnp256_ec_group();
+    auto batch=bnp256_map_to_points(basenames,bench_max_iter);
+    for (size_t i=0;i<basenames.size();++i)
+    {
+        G1_point reference=map_to_point(ecgrp,basenames[i],bench_max_iter);
+        if (reference!=bnp256_map_to_point(basenames[i],bench_max_iter) || reference!=batch[i])
+        {
+            std::cerr << "Basename: " << basenames[i].to_hex_string() << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+void write_results(std::ostream& os, size_t iterations, std::vector<Map_result> const& results)
+{
+    os << "Basenames mapped per second (" << iterations << " basenames)\n";
+    for (auto const& mr : results)
+    {
+        os << std::left << std::setw(16) << mr.name
+           << std::right << std::setw(12) << std::fixed << std::setprecision(0)
+           << iterations*1.0e6/mr.duration << '\n';
+    }
+}
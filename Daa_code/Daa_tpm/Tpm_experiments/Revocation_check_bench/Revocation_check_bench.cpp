@@ -0,0 +1,282 @@
+/*******************************************************************************
+* File:        Revocation_check_bench.cpp
+* Description: Times the revocation check as the list of revoked keys grows
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Tpm_param.h"
+#include "bnp256_param.h"
+#include "Openssl_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Get_random_bytes.h"
+#include "Clock_utils.h"
+#include "Logging.h"
+#include "G1_ecp.h"
+#include "Basename_cache.h"
+#include "Revocation_check.h"
+#include "Revocation_check_bench.h"
+
+namespace
+{
+// Scans are slow, so fewer are timed than table checks
+const size_t scans_per_size=4;
+const size_t table_checks_per_size=1000;
+
+// [f]J and [n-f]J have the same x-coordinate, and a list can hold a key
+// twice, so a list with f, n-f and f again must give the same answers with
+// and without the basename tables
+void check_negated_keys(size_t n_random_keys, size_t threads, Random_byte_generator& rbg)
+{
+    size_t random_bytes=bnp256_order.size();
+    std::vector<Byte_buffer> keys;
+    for (size_t i=0;i<n_random_keys;++i)
+    {
+        keys.push_back(bb_mod(rbg(random_bytes),bnp256_order));
+    }
+    Byte_buffer f=bb_mod(rbg(random_bytes),bnp256_order);
+    Byte_buffer minus_f=bb_mod_sub(bnp256_order,f,bnp256_order);
+    keys.push_back(f);
+    keys.push_back(minus_f);
+    keys.push_back(f);
+    Byte_buffer not_revoked=bb_mod(rbg(random_bytes),bnp256_order);
+
+    Revocation_checker scan_checker(keys,threads,0);
+    Revocation_checker table_checker(keys,threads,default_revocation_table_capacity,1);
+    std::vector<std::pair<Byte_buffer,bool>> signers{{f,true},{minus_f,true},{keys[0],true},{not_revoked,false}};
+    for (size_t i=0;i<4;++i)
+    {
+        Byte_buffer bsn=rbg(32);
+        G1_point pt_j=basename_cache().get(bsn).pt_j;
+        for (auto const& s : signers)
+        {
+            G1_point pt_k=(s.first*G1_ecp(pt_j)).to_g1_point();
+            bool scanned=scan_checker.is_revoked(bsn,pt_j,pt_k);
+            bool from_table=table_checker.is_revoked(bsn,pt_j,pt_k);
+            if (scanned!=s.second || from_table!=s.second)
+            {
+                throw(std::runtime_error("The revocation checks with and without tables differ"));
+            }
+        }
+    }
+}
+
+Revocation_cost time_checks(size_t n_keys, size_t threads, Random_byte_generator& rbg)
+{
+    size_t random_bytes=bnp256_order.size();
+    std::vector<Byte_buffer> keys;
+    for (size_t i=0;i<n_keys;++i)
+    {
+        keys.push_back(bb_mod(rbg(random_bytes),bnp256_order));
+    }
+    Byte_buffer f=bb_mod(rbg(random_bytes),bnp256_order);
+
+    Revocation_cost rc{n_keys,0.0,0.0,0.0};
+    // Each basename is checked once, so there are no tables
+    {
+        Revocation_checker checker(keys,threads,default_revocation_table_capacity,2);
+        for (size_t i=0;i<scans_per_size;++i)
+        {
+            Byte_buffer bsn=rbg(32);
+            G1_point pt_j=basename_cache().get(bsn).pt_j;
+            G1_point pt_k=(f*G1_ecp(pt_j)).to_g1_point();
+            if (checker.is_revoked(bsn,pt_j,pt_k))
+            {
+                throw(std::runtime_error("An unrevoked key was found in the revocation list"));
+            }
+        }
+        rc.scan=checker.stats().check_microseconds/scans_per_size;
+    }
+    // One basename, with a table from the first check
+    {
+        Revocation_checker checker(keys,threads,default_revocation_table_capacity,1);
+        Byte_buffer bsn=rbg(32);
+        G1_point pt_j=basename_cache().get(bsn).pt_j;
+        G1_point pt_k=(f*G1_ecp(pt_j)).to_g1_point();
+        checker.is_revoked(bsn,pt_j,pt_k);
+        rc.build=checker.stats().check_microseconds;
+        for (size_t i=0;i<table_checks_per_size;++i)
+        {
+            checker.is_revoked(bsn,pt_j,pt_k);
+        }
+        G1_point pt_revoked=(keys.back()*G1_ecp(pt_j)).to_g1_point();
+        if (!checker.is_revoked(bsn,pt_j,pt_revoked))
+        {
+            throw(std::runtime_error("A revoked key was not found"));
+        }
+        auto stats=checker.stats();
+        rc.table=(stats.check_microseconds-rc.build)/(stats.checks-1);
+    }
+    return rc;
+}
+}
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Null_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    bool bench_ok=false;
+    std::vector<Revocation_cost> results;
+    try
+    {
+        Random_byte_generator rbg;
+        // Both sides of fixed_base_min_keys
+        check_negated_keys(4,pd.threads,rbg);
+        check_negated_keys(40,pd.threads,rbg);
+        for (size_t n=16;n<=pd.max_keys;n*=4)
+        {
+            results.push_back(time_checks(n,pd.threads,rbg));
+        }
+        bench_ok=true;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (!bench_ok)
+    {
+		std::cerr << "Revocation check benchmark failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    write_results(std::cout,Revocation_checker(std::vector<Byte_buffer>(),pd.threads).number_of_threads(),results);
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-n, --number <largest number of revoked keys> - (default 4096)\n"
+                    << "\t-j, --threads <number of threads> - (default, the number of cores)\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    pd.max_keys=4096;
+    pd.threads=0;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        if ((o==Option::number || o==Option::threads) && arg==argc)
+        {
+            std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        switch (o)
+        {
+        case Option::number:
+            try
+            {
+                pd.max_keys=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid number of keys: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::threads:
+            try
+            {
+                pd.threads=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid number of threads: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        }
+    }
+
+    if (pd.max_keys<16)
+    {
+        std::cerr << "The largest number of keys must be at least 16\n";
+        return Init_result::init_failed;
+    }
+
+    return Init_result::init_ok;
+}
+
+void write_results(std::ostream& os, size_t threads, std::vector<Revocation_cost> const& results)
+{
+    os << "Microseconds per check (" << threads << " threads)\n";
+    os << std::right << std::setw(8) << "keys" << std::setw(14) << "scan"
+       << std::setw(14) << "build table" << std::setw(14) << "with table" << '\n';
+    for (auto const& rc : results)
+    {
+        os << std::setw(8) << rc.keys << std::fixed << std::setprecision(1)
+           << std::setw(14) << rc.scan << std::setw(14) << rc.build << std::setw(14) << rc.table << '\n';
+    }
+}
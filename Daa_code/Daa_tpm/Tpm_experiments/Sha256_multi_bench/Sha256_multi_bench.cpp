@@ -0,0 +1,269 @@
+/*******************************************************************************
+* File:        Sha256_multi_bench.cpp
+* Description: Compares the ways of hashing many short messages
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Tpm_param.h"
+#include "Openssl_utils.h"
+#include "Clock_utils.h"
+#include "Get_random_bytes.h"
+#include "Logging.h"
+#include "Sha.h"
+#include "Sha256_multi.h"
+#include "Sha256_multi_bench.h"
+
+namespace
+{
+const std::vector<Sha256_engine> all_engines{Sha256_engine::generic,Sha256_engine::sha_ni,Sha256_engine::avx2};
+
+// The views of, and the digests for, one batch of messages
+struct Batch
+{
+    std::vector<Byte_view> msgs;
+    std::vector<Byte_buffer> digests;
+    std::vector<Byte_ptr> outputs;
+
+    explicit Batch(std::vector<Byte_buffer> const& messages) :
+    digests(messages.size(),Byte_buffer(sha256_digest_size,0))
+    {
+        for (size_t i=0;i<messages.size();++i)
+        {
+            msgs.push_back(messages[i]);
+            outputs.push_back(digests[i].data());
+        }
+    }
+};
+
+Engine_result time_engine(Sha256_engine engine, Batch& batch, size_t rounds)
+{
+    F_timer_mu timer;
+    for (size_t r=0;r<rounds;++r)
+    {
+        sha256_multi(batch.msgs.data(),batch.outputs.data(),batch.msgs.size(),engine);
+    }
+    return Engine_result{sha256_engine_name(engine),timer.get_duration()};
+}
+
+// One message at a time through OpenSSL, as Sha256_hasher does
+Engine_result time_openssl(Batch& batch, size_t rounds)
+{
+    Sha256_hasher hasher;
+    F_timer_mu timer;
+    for (size_t r=0;r<rounds;++r)
+    {
+        for (size_t i=0;i<batch.msgs.size();++i)
+        {
+            hasher.update(batch.msgs[i]).finish(batch.outputs[i]);
+        }
+    }
+    return Engine_result{"openssl",timer.get_duration()};
+}
+}
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    log_ptr.reset(new Null_log);
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    bool bench_ok=false;
+    std::vector<Engine_result> results;
+    try
+    {
+        Random_byte_generator rbg;
+        std::vector<Byte_buffer> messages;
+        for (size_t i=0;i<pd.batch_size;++i)
+        {
+            messages.push_back(rbg(pd.message_size));
+        }
+        if (!engines_agree(messages))
+        {
+            std::cerr << "The engines give different digests\n";
+        }
+        else
+        {
+            Batch batch(messages);
+            size_t rounds=pd.messages/pd.batch_size;
+            pd.messages=rounds*pd.batch_size;
+            for (auto engine : all_engines)
+            {
+                if (sha256_engine_supported(engine))
+                {
+                    results.push_back(time_engine(engine,batch,rounds));
+                }
+            }
+            results.push_back(time_openssl(batch,rounds));
+            bench_ok=true;
+        }
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "Exception caught: " << e.what() << std::endl;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (!bench_ok)
+    {
+		std::cerr << "SHA-256 benchmark failed\n";
+       	return EXIT_FAILURE;
+    }
+
+    write_results(std::cout,pd,results);
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-n, --number <number of messages hashed by each engine> - (default 200000)\n"
+                    << "\t-s, --size <message size in bytes> - (default " << default_message_size << ")\n"
+                    << "\t-b, --batch <messages in each call> - (default 64)\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    pd.messages=200000;
+    pd.message_size=default_message_size;
+    pd.batch_size=64;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        switch (o)
+        {
+        case Option::number:
+        case Option::size:
+        case Option::batch:
+        {
+            if (arg==argc)
+            {
+                std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+                usage(std::cerr,argv[0]);
+                return Init_result::init_failed;
+            }
+            size_t value=0;
+            try
+            {
+                value=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid value: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            size_t& field=(o==Option::number)?pd.messages:(o==Option::size)?pd.message_size:pd.batch_size;
+            field=value;
+            break;
+        }
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        }
+    }
+
+    if (pd.batch_size==0 || pd.messages<pd.batch_size)
+    {
+        std::cerr << "The batch size must be at least 1, and no more than the number of messages\n";
+        return Init_result::init_failed;
+    }
+
+    return Init_result::init_ok;
+}
+
+bool engines_agree(std::vector<Byte_buffer> const& msgs)
+{
+    for (auto engine : all_engines)
+    {
+        if (!sha256_engine_supported(engine))
+        {
+            continue;
+        }
+        Batch batch(msgs);
+        sha256_multi(batch.msgs.data(),batch.outputs.data(),batch.msgs.size(),engine);
+        for (size_t i=0;i<msgs.size();++i)
+        {
+            if (batch.digests[i]!=sha256_bb(msgs[i]))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void write_results(std::ostream& os, Program_data const& pd, std::vector<Engine_result> const& results)
+{
+    os << "Hashes per second on one core (" << pd.messages << " messages of " << pd.message_size
+       << " bytes, " << pd.batch_size << " in each call)\n";
+    os << "best engine for this CPU: " << sha256_engine_name(sha256_best_engine()) << '\n';
+    for (auto const& er : results)
+    {
+        os << std::left << std::setw(12) << er.name
+           << std::right << std::setw(12) << std::fixed << std::setprecision(0)
+           << pd.messages*1.0e6/er.microseconds << '\n';
+    }
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* File:        Sha256_multi_bench.h
+* Description: Compares the ways of hashing many short messages
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Sha.h"
+#include "Sha256_multi.h"
+
+enum Init_result {init_ok=0,init_failed,init_help};
+
+enum Option {number,size,batch,help,version};
+
+const std::map<std::string,Option> program_options{
+    {"--number",number},
+    {"-n",number},
+    {"--size",size},
+    {"-s",size},
+    {"--batch",batch},
+    {"-b",batch},
+    {"--help",help},
+    {"-h",help},
+    {"--version",version},
+    {"-v",version}
+};
+
+// The default message size is that of the transcript for c with no basename:
+// the digest of the message, the credential and the points J, K, L' and E'
+const size_t default_message_size=sha256_digest_size+8*g1_affine_point_size;
+
+struct Program_data
+{
+    size_t messages;            // The number hashed by each engine
+    size_t message_size;
+    size_t batch_size;          // The number passed to each sha256_multi call
+};
+
+struct Engine_result
+{
+    std::string name;
+    float microseconds;
+};
+
+void usage(std::ostream& os, const char* name);
+
+Init_result initialise(int argc, char *argv[], Program_data& pd);
+
+// Checks that every supported engine gives the same digests as sha256_bb
+bool engines_agree(std::vector<Byte_buffer> const& msgs);
+
+void write_results(std::ostream& os, Program_data const& pd, std::vector<Engine_result> const& results);
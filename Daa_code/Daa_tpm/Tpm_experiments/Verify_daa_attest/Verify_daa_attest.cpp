@@ -64,10 +64,13 @@
 #include "Model_hashes.h"
 #include "Amcl_utils.h"
 #include "Amcl_pairings.h"
+#include "Curve_backend.h"
 #include "Tpm2_commit.h"
 #include "Daa_certify.h"
 #include "Daa_credential.h"
 #include "Openssl_ec_map_to_point.h"
+#include "Basename_cache.h"
+#include "Linkage_index.h"
 #include "Key_name_from_public_data.h"
 #include "Verify_daa_attestation.h"
 #include "Verify_daa_attest.h"
@@ -120,6 +123,7 @@ void usage(std::ostream& os, const char* name)
                     << "\t-v, --version - the code version\n"
                     << "\t-g, --debug <debug level> - (0,1,2)\n"
                     << "\t-d, --datadir <data directory> - (default .)\n"
+                    << "\t-l, --linkage <linkage index file> - count the signatures for each (basename,K)\n"
                     << "\t<attestation filename>\n";
 }
 
@@ -176,6 +180,9 @@ Init_result initialise(int argc, char *argv[],Program_data& pd)
         case Option::datadir:
             pd.file_basename=std::string(argv[arg++]);
             break;
+        case Option::linkage:
+            pd.linkage_filename=std::string(argv[arg++]);
+            break;
         case Option::debug:
             {
                 std::string level(argv[arg]);
@@ -236,6 +243,10 @@ Init_result initialise(int argc, char *argv[],Program_data& pd)
 
     log_ptr->os() << std::boolalpha << "\nUse basename: " << pd.use_basename
                   << "\nDebug level: " << debug_level << std::endl;
+    if (!pd.linkage_filename.empty())
+    {
+        log_ptr->os() << "Linkage index: " << pd.linkage_filename << std::endl;
+    }
 
     return Init_result::init_ok;
 }
@@ -395,13 +406,11 @@ Verify_result verify(Program_data& pd)
                 throw(std::runtime_error("Incorrect attestation_type"));
         }
    
-        G1_point map_pt;
         G1_point pt_j_prime;
         if (bsn.size()!=0)
         {
             Tpm_timer tt2;
-            map_pt=point_from_basename(bsn);
-            pt_j_prime=std::make_pair(bb_mod(sha256_bb(map_pt.first),bnp256_p),map_pt.second);
+            pt_j_prime=basename_cache().get(bsn).pt_j;
         }
 
         if (pt_j!=pt_j_prime)
@@ -410,38 +419,15 @@ Verify_result verify(Program_data& pd)
             throw(std::runtime_error("J!=J'"));
         }
 
-        Bn_ctx_ptr ctx =new_bn_ctx();
-        Ec_group_ptr ecgrp=new_ec_group("bnp256"); // Name ignored for now
-        if (ecgrp.get()==nullptr)
-        {
-            throw(Openssl_error("tes_daa_sign: error generating the curve"));
-        }
-        if (1!=EC_GROUP_check(ecgrp.get(),ctx.get()))
-        {
-            throw(Openssl_error("test_daa_sign: EC_GROUP_check failed"));
-        }
-
         // h_2
         G1_point l_prime_bb;
-        G1_point e_prime_bb;
-        G1_point tmp_bb;
         if (bsn.size()>0)
         {
-            // [s]J
-            G1_point s_j_bb=ec_point_mul(ecgrp,sig_s,pt_j);
-            // [h_2]K
-            G1_point h2_k_bb=ec_point_mul(ecgrp,h2,pt_k);
-            // L'
-            tmp_bb=ec_point_invert(ecgrp,h2_k_bb);
-            l_prime_bb=ec_point_add(ecgrp,s_j_bb,tmp_bb); 
+            // L'=[s]J-[h_2]K
+            l_prime_bb=Curve::multi_mul({sig_s,h2},{Curve::G1(pt_j),-Curve::G1(pt_k)}).to_g1_point();
         }
-        // [s]S
-        G1_point s_pt_s_bb=ec_point_mul(ecgrp,sig_s,r_cre[1]);
-        // [h_2]W
-        G1_point h2_pt_w_bb=ec_point_mul(ecgrp,h2,r_cre[3]);
-        // E'
-        tmp_bb=ec_point_invert(ecgrp,h2_pt_w_bb);
-        e_prime_bb=ec_point_add(ecgrp,s_pt_s_bb,tmp_bb); 
+        // E'=[s]S-[h_2]W
+        G1_point e_prime_bb=Curve::multi_mul({sig_s,h2},{Curve::G1(r_cre[1]),-Curve::G1(r_cre[3])}).to_g1_point();
 
         Byte_buffer v_c=sign_c(label,r_cre,pt_j,pt_k,l_prime_bb,e_prime_bb);
 
@@ -474,6 +460,24 @@ Verify_result verify(Program_data& pd)
         }
         tpm_timings.add(prefix+" Verifier checks "+attestation_type,dur);
 
+        // Only verified signatures are linked. The signature has verified, so
+        // a problem with the index is reported but does not change the result
+        if (!pd.linkage_filename.empty() && bsn.size()!=0)
+        {
+            try
+            {
+                Linkage_index li(pd.linkage_filename);
+                uint32_t n_linked=li.insert_or_get_count(bsn,pt_k);
+                log_ptr->os() << "Signatures with this basename and K: " << n_linked
+                              << " (" << li.size() << " pseudonyms in the index)" << std::endl;
+            }
+            catch(const std::exception& e)
+            {
+                log_ptr->os() << "The linkage index was not updated: " << e.what() << std::endl;
+                std::cerr << "The linkage index was not updated: " << e.what() << std::endl;
+            }
+        }
+
     }
     catch(const std::exception& e)
     {
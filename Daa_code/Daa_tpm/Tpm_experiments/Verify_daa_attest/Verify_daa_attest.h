@@ -46,13 +46,15 @@
 
 enum Init_result {init_ok=0,init_failed,init_help};
 
-enum Option {datadir,help,version,debug};
+enum Option {datadir,help,version,debug,linkage};
 
 const std::map<std::string,Option> program_options{
     {"--datadir",datadir},
     {"-d",datadir},
     {"--debug", debug},
     {"-g", debug},
+    {"--linkage",linkage},
+    {"-l",linkage},
     {"--help",help},
     {"-h",help},
     {"--version",version},
@@ -65,6 +67,7 @@ struct Program_data
     std::string attest_filename;
     std::string run_number;
     bool use_basename;
+    std::string linkage_filename;   // Records (basename,K) if not empty
 };
 
 void usage(std::ostream& os, const char* name);
@@ -66,10 +66,14 @@
 #include "Model_hashes.h"
 #include "Amcl_utils.h"
 #include "Amcl_pairings.h"
+#include "Curve_backend.h"
 #include "Tpm2_commit.h"
 #include "Daa_certify.h"
 #include "Daa_credential.h"
 #include "Openssl_ec_map_to_point.h"
+#include "Basename_cache.h"
+#include "Linkage_index.h"
+#include "Revocation_check.h"
 #include "Verify_daa_attestation.h"
 #include "Verify_daa_signature.h"
 
@@ -124,6 +128,8 @@ void usage(std::ostream& os, const char* name)
                     << "\t-v, --version - the code version\n"
                     << "\t-g, --debug <debug level> - (0,1,2)\n"
                     << "\t-d, --datadir <data directory> - (default .)\n"
+                    << "\t-l, --linkage <linkage index file> - count the signatures for each (basename,K)\n"
+                    << "\t-r, --revoked <revocation list file> - the revoked DAA keys, one hex value per line\n"
                     << "\t<signature filename>\n";
 }
 
@@ -180,6 +186,12 @@ Init_result initialise(int argc, char *argv[],Program_data& pd)
         case Option::datadir:
             pd.file_basename=std::string(argv[arg++]);
             break;
+        case Option::linkage:
+            pd.linkage_filename=std::string(argv[arg++]);
+            break;
+        case Option::revoked:
+            pd.revoked_filename=std::string(argv[arg++]);
+            break;
         case Option::debug:
             {
                 std::string level(argv[arg]);
@@ -240,6 +252,14 @@ Init_result initialise(int argc, char *argv[],Program_data& pd)
 
     log_ptr->os() << std::boolalpha << "\nUse basename: " << pd.use_basename
                   << "\nDebug level: " << debug_level << std::endl;
+    if (!pd.linkage_filename.empty())
+    {
+        log_ptr->os() << "Linkage index: " << pd.linkage_filename << std::endl;
+    }
+    if (!pd.revoked_filename.empty())
+    {
+        log_ptr->os() << "Revocation list: " << pd.revoked_filename << std::endl;
+    }
 
     return Init_result::init_ok;
 }
@@ -337,13 +357,11 @@ Verify_result verify(Program_data& pd)
 
         Tpm_timer tt;
 
-        G1_point map_pt;
         G1_point pt_j_prime;
         if (bsn.size()!=0)
         {
             Tpm_timer tt2;
-            map_pt=point_from_basename(bsn);
-            pt_j_prime=std::make_pair(bb_mod(sha256_bb(map_pt.first),bnp256_p),map_pt.second);
+            pt_j_prime=basename_cache().get(bsn).pt_j;
         }
         if (pt_j!=pt_j_prime)
         {
@@ -351,45 +369,23 @@ Verify_result verify(Program_data& pd)
             throw(std::runtime_error("J!=J'"));
         }
 
-        Bn_ctx_ptr ctx =new_bn_ctx();
-        Ec_group_ptr ecgrp=new_ec_group("bnp256"); // Name ignored for now
-        if (ecgrp.get()==nullptr)
-        {
-            throw(Openssl_error("tes_daa_sign: error generating the curve"));
-        }
-        if (1!=EC_GROUP_check(ecgrp.get(),ctx.get()))
-        {
-            throw(Openssl_error("test_daa_sign: EC_GROUP_check failed"));
-        }
-
         // h_2
         Byte_buffer& hash2=daa_sig[2];
         Byte_buffer& sig_s=daa_sig[1];
 
         G1_point l_prime_bb;
-        G1_point e_prime_bb;
-        G1_point tmp_bb;
         if (bsn.size()>0)
         {
-            // [s]J
-            G1_point s_j_bb=ec_point_mul(ecgrp,sig_s,pt_j);
-            // [h_2]K
-            G1_point h2_k_bb=ec_point_mul(ecgrp,hash2,pt_k);
-            // L'
-            tmp_bb=ec_point_invert(ecgrp,h2_k_bb);
-            l_prime_bb=ec_point_add(ecgrp,s_j_bb,tmp_bb); 
+            // L'=[s]J-[h_2]K
+            l_prime_bb=Curve::multi_mul({sig_s,hash2},{Curve::G1(pt_j),-Curve::G1(pt_k)}).to_g1_point();
         }
-        // [s]S
-        G1_point s_pt_s_bb=ec_point_mul(ecgrp,sig_s,r_cre[1]);
-        // [h_2]W
-        G1_point h2_pt_w_bb=ec_point_mul(ecgrp,hash2,r_cre[3]);
-        // E'
-        tmp_bb=ec_point_invert(ecgrp,h2_pt_w_bb);
-        e_prime_bb=ec_point_add(ecgrp,s_pt_s_bb,tmp_bb); 
+        // E'=[s]S-[h_2]W
+        G1_point e_prime_bb=Curve::multi_mul({sig_s,hash2},{Curve::G1(r_cre[1]),-Curve::G1(r_cre[3])}).to_g1_point();
 
         Byte_buffer v_c=sign_c(msg_digest,r_cre,pt_j,pt_k,l_prime_bb,e_prime_bb);
 
-        Byte_buffer h2_prime=bb_mod(sha256_bb(daa_sig[0]+sha256_bb(v_c)),bnp256_order);
+        // h_2=H(n_M|H(c)) mod n
+        Byte_buffer h2_prime=Transcript().add(daa_sig[0]).add(Transcript().add(v_c).digest()).to_scalar().to_byte_buffer();
 
 
         if (h2_prime!=hash2)
@@ -410,6 +406,38 @@ Verify_result verify(Program_data& pd)
         std::string prefix=(pd.use_basename)?"T12B":"T12N";
         tpm_timings.add(prefix+" verify signature",dur);
         tpm_timings.add("T13 Verifier checks pairings (S,C,Q)",dur2);
+
+        if (!pd.revoked_filename.empty() && bsn.size()!=0)
+        {
+            Revocation_checker rc(read_revocation_list(pd.revoked_filename));
+            bool revoked=rc.is_revoked(bsn,pt_j,pt_k);
+            auto rs=rc.stats();
+            log_ptr->os() << "Revocation check against " << rc.size() << " keys: " << rs.check_microseconds
+                          << " microseconds, " << rs.points << " points calculated" << std::endl;
+            if (revoked)
+            {
+                log_ptr->write_to_log("The signature was made with a revoked DAA key\n");
+                return Verify_result::verify_failed;
+            }
+        }
+
+        // Only verified signatures are linked. The signature has verified, so
+        // a problem with the index is reported but does not change the result
+        if (!pd.linkage_filename.empty() && bsn.size()!=0)
+        {
+            try
+            {
+                Linkage_index li(pd.linkage_filename);
+                uint32_t n_linked=li.insert_or_get_count(bsn,pt_k);
+                log_ptr->os() << "Signatures with this basename and K: " << n_linked
+                              << " (" << li.size() << " pseudonyms in the index)" << std::endl;
+            }
+            catch(const std::exception& e)
+            {
+                log_ptr->os() << "The linkage index was not updated: " << e.what() << std::endl;
+                std::cerr << "The linkage index was not updated: " << e.what() << std::endl;
+            }
+        }
     }
     catch(const std::exception& e)
     {
@@ -46,13 +46,17 @@
 
 enum Init_result {init_ok=0,init_failed,init_help};
 
-enum Option {datadir,help,version,debug};
+enum Option {datadir,help,version,debug,linkage,revoked};
 
 const std::map<std::string,Option> program_options{
     {"--datadir",datadir},
     {"-d",datadir},
     {"--debug", debug},
     {"-g", debug},
+    {"--linkage",linkage},
+    {"-l",linkage},
+    {"--revoked",revoked},
+    {"-r",revoked},
     {"--help",help},
     {"-h",help},
     {"--version",version},
@@ -65,6 +69,8 @@ struct Program_data
     std::string signature_filename;
     std::string run_number;
     bool use_basename;
+    std::string linkage_filename;   // Records (basename,K) if not empty
+    std::string revoked_filename;   // Checks K against the revoked keys if not empty
 };
 
 void usage(std::ostream& os, const char* name);
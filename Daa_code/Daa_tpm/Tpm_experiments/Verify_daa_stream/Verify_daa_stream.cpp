@@ -0,0 +1,401 @@
+/*******************************************************************************
+* File:        Verify_daa_stream.cpp
+* Description: A long-running verifier for streams of DAA signatures and attestations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "Tss_includes.h"
+#include "Tpm_utils.h"
+#include "Tpm_param.h"
+#include "Openssl_utils.h"
+#include "Marshal_public_data.h"
+#include "Key_name_from_public_data.h"
+#include "Daa_records.h"
+#include "Daa_stream_verifier.h"
+#include "Async_log.h"
+#include "Verify_daa_stream.h"
+
+int main(int argc, char *argv[])
+{
+	Program_data pd;
+   	init_openssl();
+
+    auto ir=initialise(argc,argv,pd);
+    if (ir!=Init_result::init_ok)
+    {
+        if (ir==Init_result::init_help)
+            return EXIT_SUCCESS;
+            
+        return EXIT_FAILURE;
+    }
+
+    // A client that goes away must not stop the verifier
+    signal(SIGPIPE,SIG_IGN);
+
+    bool stream_ok=true;
+    try
+    {
+        Stream_verifier sv(pd.threads,check_attestation_data);
+        log_ptr->os() << "Verifying with " << sv.number_of_threads() << " threads" << std::endl;
+        switch (pd.input)
+        {
+        case Input_type::standard_input:
+            verify_input(sv,STDIN_FILENO,STDOUT_FILENO);
+            break;
+        case Input_type::fifo:
+            serve_fifo(sv,pd.input_path);
+            break;
+        case Input_type::unix_socket:
+            serve_socket(sv,pd.input_path);
+            break;
+        }
+        auto stats=sv.stats();
+        log_ptr->os() << "Records: " << stats.requests << ", verified: " << stats.verified
+                      << ", failed: " << stats.failed << std::endl;
+    }
+    catch(const std::exception& e)
+    {
+        log_ptr->os() << "Exception caught: " << e.what() << std::endl;
+        std::cerr << e.what() << std::endl;
+        stream_ok=false;
+    }
+   
+ 	cleanup_openssl();
+	
+	if (!stream_ok)
+    {
+       	return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void usage(std::ostream& os, const char* name)
+{
+	os << "Usage: " << name << "\n\t-h, --help - this message\n"
+                    << "\t-v, --version - the code version\n"
+                    << "\t-g, --debug <debug level> - (0,1,2)\n"
+                    << "\t-d, --datadir <data directory for the log> - (default .)\n"
+                    << "\t-f, --fifo <FIFO to read> - (default, read standard input)\n"
+                    << "\t-u, --socket <Unix socket to listen on>\n"
+                    << "\t-j, --threads <number of threads> - (default, the number of cores)\n"
+                    << "Each record is a line: <id> <sign|certify|quote> <bsn|no_bsn> <length>\n"
+                    << "followed by length bytes, the contents of a signature or attestation file,\n"
+                    << "or a line: <id> wire <length> followed by a record in the binary format.\n"
+                    << "A line \"<id> ok\", or \"<id> failed <reason>\", is written for each record.\n";
+}
+
+Init_result initialise(int argc, char *argv[],Program_data& pd)
+{
+    // Option defaults
+    int debug_level=0;
+    pd.file_basename=".";
+    pd.input=Input_type::standard_input;
+    pd.threads=0;
+ 
+    int arg=1;
+    while (arg<argc)
+    {
+        auto search=program_options.find(argv[arg++]);
+        if (search==program_options.end())
+        {
+            std::cerr << "Invalid option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        Option o=search->second;
+        if (o!=Option::help && o!=Option::version && arg==argc)
+        {
+            std::cerr << "Missing value for option: " << argv[arg-1] << '\n';
+            usage(std::cerr,argv[0]);
+            return Init_result::init_failed;
+        }
+        switch (o)
+        {
+        case Option::datadir:
+            pd.file_basename=std::string(argv[arg++]);
+            break;
+        case Option::fifo:
+        case Option::socket_path:
+            if (pd.input!=Input_type::standard_input)
+            {
+                std::cerr << "Only one input can be selected\n";
+                usage(std::cerr,argv[0]);
+                return Init_result::init_failed;
+            }
+            pd.input=(o==Option::fifo)?Input_type::fifo:Input_type::unix_socket;
+            pd.input_path=std::string(argv[arg++]);
+            break;
+        case Option::threads:
+            try
+            {
+                pd.threads=std::stoul(argv[arg++]);
+            }
+            catch (std::exception const&)
+            {
+                std::cerr << "Invalid number of threads: " << argv[arg-1] << '\n';
+                return Init_result::init_failed;
+            }
+            break;
+        case Option::debug:
+            {
+                std::string level(argv[arg]);
+                if (level!="0" && level!="1" && level!="2")
+                {
+                    usage(std::cerr,argv[0]);
+                    std::cerr << "Debug levels are 0, 1 or 2 (default 0)\n";
+                    return Init_result::init_failed;            
+                }
+                debug_level=atoi(argv[arg++]);
+            }
+            break;
+        case Option::help:
+            usage(std::cout,argv[0]);
+            return Init_result::init_help;
+        case Option::version:
+            std::cout << code_version << '\n';
+            return Init_result::init_help;
+        }
+    }
+
+    // The results go to standard output, so the log is always a file. It is
+    // written on its own thread, so the verifier threads do not wait for it
+    std::string filename=pd.file_basename+"/Daa_verify_stream_log";
+    try
+	{
+		log_ptr.reset(new Async_log(Log_ptr(new File_log(filename))));
+	}
+	catch (std::runtime_error &e)
+	{
+		std::cerr << e.what() << '\n';
+		return Init_result::init_failed;
+	}
+
+	log_ptr->set_debug_level(debug_level);
+
+    std::string input_name=(pd.input==Input_type::standard_input)?"standard input":pd.input_path;
+    log_ptr->os() << "\nInput: " << input_name
+                  << "\nDebug level: " << debug_level << std::endl;
+
+    return Init_result::init_ok;
+}
+
+void verify_input(Stream_verifier& sv, int in_fd, int out_fd)
+{
+    auto writer=std::make_shared<Result_writer>(out_fd);
+    Frame_reader reader(in_fd);
+    Verify_request req;
+    try
+    {
+        while (reader.next(req))
+        {
+            sv.submit(req,writer);
+        }
+    }
+    catch (std::exception const& e)
+    {
+        LOG_DEBUG(0,"Input abandoned: {}",e.what());
+    }
+    writer->wait_for_results();
+}
+
+void serve_fifo(Stream_verifier& sv, std::string const& path)
+{
+    struct stat st;
+    if (stat(path.c_str(),&st)!=0)
+    {
+        if (mkfifo(path.c_str(),0600)!=0)
+        {
+            throw(std::runtime_error("Unable to make the FIFO "+path+": "+std::strerror(errno)));
+        }
+    }
+    else if (!S_ISFIFO(st.st_mode))
+    {
+        throw(std::runtime_error(path+" is not a FIFO"));
+    }
+    while (true)
+    {
+        // Blocks until there is a writer
+        int fd=open(path.c_str(),O_RDONLY);
+        if (fd<0)
+        {
+            throw(std::runtime_error("Unable to open the FIFO "+path+": "+std::strerror(errno)));
+        }
+        verify_input(sv,fd,STDOUT_FILENO);
+        close(fd);
+    }
+}
+
+namespace
+{
+// The connections being served. Finished connections are joined and closed
+// before each accept. On leaving serve_socket the remaining connections are
+// shut down and joined, so no thread is left using the verifier.
+class Connections
+{
+public:
+    explicit Connections(Stream_verifier& sv) : sv_(sv) {}
+    void add(int fd)
+    {
+        reap();
+        connections_.emplace_back();
+        Connection& c=connections_.back();
+        c.fd=fd;
+        c.done=false;
+        Stream_verifier& sv=sv_;
+        c.worker=std::thread([&sv,&c](){
+            verify_input(sv,c.fd,c.fd);
+            c.done=true;
+        });
+    }
+    ~Connections()
+    {
+        for (auto& c : connections_)
+        {
+            shutdown(c.fd,SHUT_RDWR);
+        }
+        for (auto& c : connections_)
+        {
+            c.worker.join();
+            close(c.fd);
+        }
+    }
+private:
+    struct Connection
+    {
+        int fd;
+        std::atomic<bool> done;
+        std::thread worker;
+    };
+
+    void reap()
+    {
+        for (auto it=connections_.begin();it!=connections_.end();)
+        {
+            if (it->done)
+            {
+                it->worker.join();
+                close(it->fd);
+                it=connections_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    Stream_verifier& sv_;
+    std::list<Connection> connections_;
+};
+}
+
+void serve_socket(Stream_verifier& sv, std::string const& path)
+{
+    sockaddr_un addr;
+    std::memset(&addr,0,sizeof(addr));
+    addr.sun_family=AF_UNIX;
+    if (path.size()>=sizeof(addr.sun_path))
+    {
+        throw(std::runtime_error("The socket path is too long: "+path));
+    }
+    std::strncpy(addr.sun_path,path.c_str(),sizeof(addr.sun_path)-1);
+
+    int server=socket(AF_UNIX,SOCK_STREAM,0);
+    if (server<0)
+    {
+        throw(std::runtime_error(std::string("Unable to make a socket: ")+std::strerror(errno)));
+    }
+    unlink(path.c_str());
+    if (bind(server,reinterpret_cast<sockaddr*>(&addr),sizeof(addr))!=0 || listen(server,16)!=0)
+    {
+        close(server);
+        throw(std::runtime_error("Unable to listen on "+path+": "+std::strerror(errno)));
+    }
+    Connections connections(sv);
+    while (true)
+    {
+        int conn=accept(server,nullptr,nullptr);
+        if (conn<0)
+        {
+            if (errno==EINTR)
+                continue;
+
+            close(server);
+            throw(std::runtime_error(std::string("accept failed: ")+std::strerror(errno)));
+        }
+        connections.add(conn);
+    }
+}
+
+bool check_attestation_data(Daa_attestation_record const& rec)
+{
+    Byte_buffer cert=rec.cert;
+    TPMS_ATTEST att_cert;
+    if (unmarshal_attest_data_B(cert,&att_cert)!=0)
+    {
+        LOG_DEBUG(1,"Unable to unmarshal the attestation data");
+        return false;
+    }
+
+    if (rec.type=="certify")
+    {
+        Byte_buffer k_name=get_key_name_bb(rec.key_pd);
+        TPMS_CERTIFY_INFO const& cert_info=att_cert.attested.certify;
+        Byte_buffer a_name(cert_info.name.t.name,cert_info.name.t.size);
+        return k_name.size()!=0 && a_name==k_name;
+    }
+
+    TPMS_QUOTE_INFO const& quote_info=att_cert.attested.quote;
+    Byte_buffer a_digest(quote_info.pcrDigest.t.buffer,quote_info.pcrDigest.t.size);
+    return a_digest==quote_digest_expected;
+}
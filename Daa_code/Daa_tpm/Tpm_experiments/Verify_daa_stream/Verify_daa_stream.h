@@ -0,0 +1,99 @@
+/*******************************************************************************
+* File:        Verify_daa_stream.h
+* Description: A long-running verifier for streams of DAA signatures and attestations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include "Daa_records.h"
+#include "Daa_stream_verifier.h"
+
+enum Init_result {init_ok=0,init_failed,init_help};
+
+enum Option {datadir,fifo,socket_path,threads,help,version,debug};
+
+const std::map<std::string,Option> program_options{
+    {"--datadir",datadir},
+    {"-d",datadir},
+    {"--fifo",fifo},
+    {"-f",fifo},
+    {"--socket",socket_path},
+    {"-u",socket_path},
+    {"--threads",threads},
+    {"-j",threads},
+    {"--debug", debug},
+    {"-g", debug},
+    {"--help",help},
+    {"-h",help},
+    {"--version",version},
+    {"-v",version}
+};
+
+enum class Input_type {standard_input,fifo,unix_socket};
+
+struct Program_data
+{
+    std::string file_basename;
+    Input_type input;
+    std::string input_path;     // The FIFO or socket
+    size_t threads;             // 0 for one thread per core
+};
+
+void usage(std::ostream& os, const char* name);
+
+Init_result initialise(int argc, char *argv[], Program_data& pd);
+
+// Verifies the records read from in_fd until it ends, writing the results to
+// out_fd. A badly formed frame loses the framing, so the rest of the input
+// is dropped.
+void verify_input(Stream_verifier& sv, int in_fd, int out_fd);
+
+// Reads from a FIFO, reopening it each time the writer closes it. The FIFO
+// is made if path does not exist, and any other kind of file is an error.
+void serve_fifo(Stream_verifier& sv, std::string const& path);
+
+// Verifies the records from each connection on its own thread, returning
+// the results on the connection. The threads are joined before it returns
+// or throws.
+void serve_socket(Stream_verifier& sv, std::string const& path);
+
+// The certified key's name, or the PCR digest, in the attested data
+bool check_attestation_data(Daa_attestation_record const& rec);
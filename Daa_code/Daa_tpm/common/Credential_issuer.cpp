@@ -42,6 +42,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include "Byte_buffer.h"
 #include "Marshal_public_data.h"
 #include "Get_random_bytes.h"
@@ -54,7 +55,9 @@
 #include "Openssl_verify.h"
 #include "Daa_credential.h"
 #include "Model_hashes.h"
+#include "Scalar_bnp256.h"
 #include "Amcl_pairings.h"
+#include "Curve_backend.h"
 #include "Tpm_defs.h"
 
 Credential_issuer::Credential_issuer() : sk_x_(iso_sk_x), sk_y_(iso_sk_y)
@@ -72,9 +75,14 @@ TPM_RC Credential_issuer::set_daa_public_data(Byte_buffer const& daa_pd)
 
 Credential_data Credential_issuer::make_credential_data()
 {
-    appl_.current_k_cal = rbg_(credential_key_bytes_);
+	return make_credential_data(appl_,rbg_);
+}
+
+Credential_data Credential_issuer::make_credential_data(Daa_applicant_data& appl, Random_byte_generator& rbg) const
+{
+    appl.current_k_cal = rbg(credential_key_bytes_);
 
-	return make_credential_issuer(appl_.ek,appl_.daa_pd,appl_.current_k_cal,rbg_);
+	return make_credential_issuer(appl.ek,appl.daa_pd,appl.current_k_cal,rbg);
 }
 
 bool Credential_issuer::check_daa_signature(bool new_daa_signature,
@@ -107,17 +115,14 @@ bool Credential_issuer::check_daa_signature(bool new_daa_signature,
     return verified_ok;
 }
 
-std::pair<Daa_credential,Daa_credential_signature> Credential_issuer::make_daa_credential()
+std::pair<Daa_credential,Daa_credential_signature> Credential_issuer::make_daa_credential(
+Daa_applicant_data const& appl,
+Random_byte_generator& rbg
+) const
 {
-	G1_point daa_public_key=get_daa_key_from_public_data(appl_.daa_pd);
+	G1_point daa_public_key=get_daa_key_from_public_data(appl.daa_pd);
 
-    size_t random_bytes=daa_public_key.first.size();
-
-    Ec_group_ptr ecgrp=new_ec_group("bnp256"); // Curve name ignored at the moment
-    if (ecgrp==NULL)
-    {
-        throw(Tpm_error("Error generating the BN_P256 curve"));
-    }
+    Ec_group_ptr const& ecgrp=bnp256_ec_group();
 
     if (!point_is_on_curve(ecgrp,daa_public_key))
     {
@@ -125,30 +130,14 @@ std::pair<Daa_credential,Daa_credential_signature> Credential_issuer::make_daa_c
     }
 
     Byte_buffer x=sk_x_;
-    Byte_buffer y=sk_y_;
+    Scalar_bnp256 y(sk_y_);
 
     Daa_credential cre;
     G1_point p1=std::make_pair(bnp256_gX,bnp256_gY); // Generator
 
-    Bn_ctx_ptr ctx=new_bn_ctx();
-    Bn_ptr bn_n=new_bn();
-    BN_bin2bn(&bnp256_order[0],bnp256_order.size(),bn_n.get());
-    Bn_ptr bn_x=new_bn();
-    BN_bin2bn(&x[0],x.size(),bn_x.get());
-    Bn_ptr bn_y=new_bn();
-    BN_bin2bn(&y[0],y.size(),bn_y.get());
-    Bn_ptr bn_r=new_bn();
-    Bn_ptr bn_ry=new_bn();
-
-    Byte_buffer r;
-
-    Ec_point_ptr pt_qs=new_ec_point(ecgrp);
-    bb2point(ecgrp,daa_public_key,pt_qs);
-    Ec_point_ptr pt_a=new_ec_point(ecgrp);
-    Ec_point_ptr pt_b=new_ec_point(ecgrp);
-    Ec_point_ptr pt_c=new_ec_point(ecgrp);
-    Ec_point_ptr pt_d=new_ec_point(ecgrp);
-    Ec_point_ptr pt_tmp=new_ec_point(ecgrp);
+    Curve::G1_prepared q_s(Curve::G1{daa_public_key}); // Q_s is used for D and R_D
+
+    Scalar_bnp256 ry;
 
     bool cre_ok=false;
 	while (!cre_ok)
@@ -156,44 +145,23 @@ std::pair<Daa_credential,Daa_credential_signature> Credential_issuer::make_daa_c
         cre_ok=true;
         try
         {  
-            r=rbg_(random_bytes);
-            BN_bin2bn(&r[0],r.size(),bn_r.get());
+            Scalar_bnp256 r=random_scalar_mod_n(rbg);
+            ry=r*y;
+            Byte_buffer ry_bb=ry.to_byte_buffer();
             // A=[r]P_1
-            if (1!=EC_POINT_mul(ecgrp.get(),pt_a.get(),bn_r.get(),NULL,NULL,ctx.get()))
-            {
-                throw(Openssl_error("EC multiplication failed: [r]P_1"));
-            }
-            // B=[y]A
-          	if (1!=EC_POINT_mul(ecgrp.get(),pt_b.get(),NULL,pt_a.get(),bn_y.get(),ctx.get()))
-	        {
-                throw(Openssl_error("EC multiplication failed: [y]A"));           
-            }
-            if (1!=BN_mod_mul(bn_ry.get(),bn_r.get(),bn_y.get(),bn_n.get(),ctx.get()))
-            {
-                throw(Openssl_error("Modular multiplication failed ry"));
-            }
+            Curve::G1 pt_a=Curve::generator_mul(r.to_byte_buffer());
+            // B=[y]A=[ry]P_1
+            Curve::G1 pt_b=Curve::generator_mul(ry_bb);
             // D=[ry]Q_s
-          	if (1!=EC_POINT_mul(ecgrp.get(),pt_d.get(),NULL,pt_qs.get(),bn_ry.get(),ctx.get()))
-	        {
-                throw(Openssl_error("EC multiplication failed: [ry]Q_s"));           
-            }
-            // tmp=A+D
-           	if (1!=EC_POINT_add(ecgrp.get(),pt_tmp.get(),pt_a.get(),pt_d.get(),ctx.get()))
-            {
-                throw(Openssl_error("ec_point_add failed A+D"));
-            }
-            // C=[x]tmp
-          	if (1!=EC_POINT_mul(ecgrp.get(),pt_c.get(),NULL,pt_tmp.get(),bn_x.get(),ctx.get()))
-	        {
-                throw(Openssl_error("EC multiplication failed: [ry]Q_s"));           
-            }
+            Curve::G1 pt_d=q_s.mul(ry_bb);
+            // C=[x](A+D)
+            Curve::G1 pt_c=x*(pt_a+pt_d);
 
-            cre[0]=point2bb(ecgrp,pt_a);
-            cre[1]=point2bb(ecgrp,pt_b);
-            cre[2]=point2bb(ecgrp,pt_c);
-            cre[3]=point2bb(ecgrp,pt_d);
+            // One field inversion for the four points
+            auto pts=Curve::batch_to_g1_points({pt_a,pt_b,pt_c,pt_d});
+            std::copy(pts.begin(),pts.end(),cre.begin());
         }
-        catch(Openssl_error const& e)
+        catch(std::runtime_error const& e)
         {
             if (log_ptr->debug_level()>0)
             {
@@ -205,31 +173,38 @@ std::pair<Daa_credential,Daa_credential_signature> Credential_issuer::make_daa_c
     
     Daa_credential_signature sig;
 
-    Byte_buffer nl=bb_mod(rbg_(random_bytes),bnp256_order);
-    G1_point r_b=ec_point_mul(ecgrp,nl,p1); // R_B
-    G1_point r_d=ec_point_mul(ecgrp,nl,daa_public_key); // R_D
-    
-    Byte_buffer ry;
-    ry=bb_mod_mul(r,y,bnp256_order);
+    Scalar_bnp256 nl=random_scalar_mod_n(rbg);
+    Byte_buffer nl_bb=nl.to_byte_buffer();
+    auto r_pts=Curve::batch_to_g1_points({Curve::generator_mul(nl_bb),q_s.mul(nl_bb)});
+    G1_point const& r_b=r_pts[0];   // R_B
+    G1_point const& r_d=r_pts[1];   // R_D
     
     sig[0]=issuer_u(p1,daa_public_key,cre,r_b,r_d);
-    sig[1]=bb_signature_calc(nl,ry,sig[0],bnp256_order);
+    sig[1]=(nl+ry*Scalar_bnp256(sig[0])).to_byte_buffer();
 
     return std::make_pair(cre,sig);
 }
 
 std::pair<Credential_data, Byte_buffer> Credential_issuer::make_full_credential()
 {
-	Credential_data cd=make_credential_data();
+	return make_full_credential(appl_,rbg_);
+}
+
+std::pair<Credential_data, Byte_buffer> Credential_issuer::make_full_credential(
+Daa_applicant_data& appl,
+Random_byte_generator& rbg
+) const
+{
+	Credential_data cd=make_credential_data(appl,rbg);
 
-	auto daa_cre=make_daa_credential();
+	auto daa_cre=make_daa_credential(appl,rbg);
 	std::vector<Byte_buffer> tmp_bv(2);
 	tmp_bv[0]=serialise_daa_credential(daa_cre.first);
 	tmp_bv[1]=serialise_daa_credential_signature(daa_cre.second);
 	Byte_buffer cre=serialise_byte_buffers(tmp_bv);
 
  	Byte_buffer initial_iv(aes_block_size,0);
-    Byte_buffer c_hat=ossl_encrypt("AES-128-CTR",cre,appl_.current_k_cal,initial_iv);
+    Byte_buffer c_hat=ossl_encrypt("AES-128-CTR",cre,appl.current_k_cal,initial_iv);
 
 	return std::make_pair(cd,c_hat);
 }
@@ -0,0 +1,114 @@
+/*******************************************************************************
+* File:        Issuer_engine.cpp
+* Description: A thread safe issuer that processes join requests concurrently
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include <algorithm>
+#include "Byte_buffer.h"
+#include "Get_random_bytes.h"
+#include "Marshal_public_data.h"
+#include "Tpm_error.h"
+#include "Credential_issuer.h"
+#include "Issuer_engine.h"
+
+Issuer_engine::Issuer_engine(size_t number_of_threads) : stopping_(false)
+{
+	if (number_of_threads==0)
+	{
+		number_of_threads=std::max(1U,std::thread::hardware_concurrency());
+	}
+	for (size_t i=0;i<number_of_threads;++i)
+	{
+		workers_.emplace_back(&Issuer_engine::run_worker,this);
+	}
+}
+
+Issuer_engine::~Issuer_engine()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobs_mutex_);
+		stopping_=true;
+	}
+	jobs_cv_.notify_all();
+	for (auto& w : workers_)
+	{
+		w.join();
+	}
+}
+
+std::future<Issuer_engine::Join_result> Issuer_engine::submit_join(Byte_buffer const& ek, Byte_buffer const& daa_pd)
+{
+	std::packaged_task<Join_result()> job([this,ek,daa_pd]()
+	{
+		Daa_applicant_data appl;
+		appl.ek=ek;
+		Byte_buffer daad=daa_pd;
+		if (unmarshal_public_data_B(daad,&appl.daa_pd)!=0)
+		{
+			throw(Tpm_error("submit_join: unmarshalling the DAA public data failed"));
+		}
+		return issuer_.make_full_credential(appl,thread_random_generator());
+	});
+	std::future<Join_result> result=job.get_future();
+	{
+		std::lock_guard<std::mutex> lock(jobs_mutex_);
+		jobs_.push_back(std::move(job));
+	}
+	jobs_cv_.notify_one();
+	return result;
+}
+
+void Issuer_engine::run_worker()
+{
+	while (true)
+	{
+		std::packaged_task<Join_result()> job;
+		{
+			std::unique_lock<std::mutex> lock(jobs_mutex_);
+			jobs_cv_.wait(lock,[this]{return stopping_ || !jobs_.empty();});
+			if (jobs_.empty())
+			{
+				return;	// Stopping, with nothing left to do
+			}
+			job=std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		job();	// Exceptions are passed on through the future
+	}
+}
@@ -0,0 +1,381 @@
+/*******************************************************************************
+* File:        Software_daa.cpp
+* Description: A software implementation of the DAA signing operations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+
+#include <cstring>
+#include <string>
+#include "Byte_buffer.h"
+#include "Tss_includes.h"
+#include "Tpm_error.h"
+#include "Tpm_defs.h"
+#include "Marshal_public_data.h"
+#include "Key_name_from_public_data.h"
+#include "bnp256_param.h"
+#include "Openssl_bn_utils.h"
+#include "Openssl_ec_utils.h"
+#include "Sha.h"
+#include "Hmac.h"
+#include "Software_daa.h"
+#include "Scalar_bnp256.h"
+#include "G1_ecp.h"
+#include "G1_fixed_base.h"
+
+namespace
+{
+// The TPM's wire format is big-endian
+void append_uint16(Byte_buffer& bb, uint16_t v)
+{
+	bb.push_back(static_cast<Byte>(v>>8));
+	bb.push_back(static_cast<Byte>(v));
+}
+
+void append_uint32(Byte_buffer& bb, uint32_t v)
+{
+	append_uint16(bb,static_cast<uint16_t>(v>>16));
+	append_uint16(bb,static_cast<uint16_t>(v));
+}
+
+void append_uint64(Byte_buffer& bb, uint64_t v)
+{
+	append_uint32(bb,static_cast<uint32_t>(v>>32));
+	append_uint32(bb,static_cast<uint32_t>(v));
+}
+
+// A TPM2B: the size followed by the bytes
+void append_tpm2b(Byte_buffer& bb, Byte_buffer const& data)
+{
+	append_uint16(bb,static_cast<uint16_t>(data.size()));
+	bb+=data;
+}
+
+void set_ecc_parameter(TPM2B_ECC_PARAMETER& param, Byte_buffer const& v)
+{
+	Byte_buffer padded=v;
+	padded.pad_left(component_size);
+	param.t.size=padded.size();
+	memcpy(param.t.buffer,padded.cdata(),padded.size());
+}
+
+// The public area of an ECC signing key, as made by create_daa_key or create_ecdsa_key
+void make_ecc_public(TPM2B_PUBLIC& pub, bool daa_key, G1_point const& pt)
+{
+	TPMT_PUBLIC& tpmt_public=pub.publicArea;
+	tpmt_public.type=TPM_ALG_ECC;
+	tpmt_public.nameAlg=TPM_ALG_SHA256;
+	tpmt_public.objectAttributes.val=TPMA_OBJECT_FIXEDTPM |
+		TPMA_OBJECT_NODA |
+		TPMA_OBJECT_FIXEDPARENT |
+		TPMA_OBJECT_SENSITIVEDATAORIGIN |
+		TPMA_OBJECT_USERWITHAUTH |
+		TPMA_OBJECT_SIGN;
+	tpmt_public.authPolicy.t.size=0;
+	tpmt_public.parameters.eccDetail.symmetric.algorithm=TPM_ALG_NULL;
+	if (daa_key)
+	{
+		tpmt_public.objectAttributes.val|=TPMA_OBJECT_RESTRICTED;
+		tpmt_public.parameters.eccDetail.scheme.scheme=TPM_ALG_ECDAA;
+		tpmt_public.parameters.eccDetail.scheme.details.ecdaa.hashAlg=TPM_ALG_SHA256;
+		tpmt_public.parameters.eccDetail.scheme.details.ecdaa.count=1;
+		tpmt_public.parameters.eccDetail.curveID=TPM_ECC_BN_P256;
+	}
+	else
+	{
+		tpmt_public.parameters.eccDetail.scheme.scheme=TPM_ALG_ECDSA;
+		tpmt_public.parameters.eccDetail.scheme.details.ecdsa.hashAlg=TPM_ALG_SHA256;
+		tpmt_public.parameters.eccDetail.curveID=TPM_ECC_NIST_P256;
+	}
+	tpmt_public.parameters.eccDetail.kdf.scheme=TPM_ALG_NULL;
+	set_ecc_parameter(tpmt_public.unique.ecc.x,pt.first);
+	set_ecc_parameter(tpmt_public.unique.ecc.y,pt.second);
+}
+}
+
+Software_daa::Software_daa() : commit_count_(0), clock_(0)
+{
+	for (auto& pcr : pcrs_)
+	{
+		pcr=Byte_buffer(sha256_bytes,0);
+	}
+}
+
+TPM_RC Software_daa::create_and_load_daa_key(Byte_buffer& daa_pd)
+{
+	TPM_RC rc=0;
+	try
+	{
+		daa_sk_=random_scalar_mod_n(rbg_).to_byte_buffer();
+		G1_point daa_key=g1_generator_table().mul(daa_sk_).to_g1_point();
+
+		TPM2B_PUBLIC pub;
+		make_ecc_public(pub,true,daa_key);
+		daa_pd=marshal_public_data_B(&pub);
+		daa_name_=get_key_name(&pub.publicArea);
+		if (daa_pd.size()==0)
+		{
+			throw(Tpm_error("Marshalling the DAA key public data failed"));
+		}
+		commits_.clear();
+	}
+	catch (std::runtime_error &e)
+	{
+		rc=1;
+		last_error_=std::string(e.what());
+	}
+	return rc;
+}
+
+TPM_RC Software_daa::create_and_load_pseudonym_key(int& id, Byte_buffer& qps_pd)
+{
+	TPM_RC rc=0;
+	try
+	{
+		Ec_group_ptr ecgrp=new_ec_group("prime256v1");
+		Ec_key_pair_bb key=get_new_key_pair(ecgrp);
+		if (key.first.size()==0)
+		{
+			throw(Tpm_error("Creating a pseudonym key failed"));
+		}
+
+		TPM2B_PUBLIC pub;
+		make_ecc_public(pub,false,key.second);
+		Byte_buffer pd=marshal_public_data_B(&pub);
+		if (pd.size()==0)
+		{
+			throw(Tpm_error("Marshalling pseudonym key public data failed"));
+		}
+		id=static_cast<int>(pseudonym_names_.size());
+		pseudonym_names_.push_back(get_key_name(&pub.publicArea));
+		qps_pd=std::move(pd);
+	}
+	catch (std::runtime_error &e)
+	{
+		rc=1;
+		last_error_=std::string(e.what());
+	}
+	return rc;
+}
+
+TPM_RC Software_daa::initiate_daa_signature(Byte_buffer const& s2, Byte_buffer const& y2,
+		G1_point const& pt_s, Commit_data& cd)
+{
+	TPM_RC rc=0;
+	try
+	{
+		if (daa_sk_.size()==0)
+		{
+			throw(Tpm_error("No DAA key"));
+		}
+		if ((s2.size()==0)!=(y2.size()==0))
+		{
+			throw(Tpm_error("Inconsistent data for TPM2_Commit"));
+		}
+
+		// As TPM2_Commit: E=[r]S (or [r]P_1 if S is not given) and, if s2 is
+		// given, J=(H(s2),y2), K=[f]J and L=[r]J
+		Byte_buffer r=random_scalar_mod_n(rbg_).to_byte_buffer();
+		Commit_points pts;
+		if (s2.size()!=0)
+		{
+			G1_ecp pt_j(std::make_pair(bb_mod(sha256_bb(s2),bnp256_p),y2));
+			pts[0]=(daa_sk_*pt_j).to_g1_point();
+			pts[1]=(r*pt_j).to_g1_point();
+		}
+		if (pt_s.first.size()!=0)
+		{
+			pts[2]=(r*G1_ecp(pt_s)).to_g1_point();
+		}
+		else
+		{
+			pts[2]=g1_generator_table().mul(r).to_g1_point();
+		}
+
+		uint16_t counter=++commit_count_;
+		commits_[counter]=r;
+		cd=std::make_pair(counter,pts);
+	}
+	catch (std::runtime_error &e)
+	{
+		rc=1;
+		last_error_=std::string(e.what());
+	}
+	return rc;
+}
+
+TPM_RC Software_daa::complete_daa_signature(uint16_t counter, Byte_buffer const& p,
+									   Byte_buffer& k, Byte_buffer& w)
+{
+	TPM_RC rc=0;
+	try
+	{
+		w=ecdaa_sign(counter,sha256_bb(p),k);
+	}
+	catch (std::runtime_error &e)
+	{
+		rc=1;
+		last_error_=std::string(e.what());
+	}
+	return rc;
+}
+
+TPM_RC Software_daa::certify_and_sign(int id, uint16_t counter, Byte_buffer const& c, Byte_buffer& a_cert,
+                Byte_buffer& nt, Byte_buffer& s)
+{
+	TPM_RC rc=0;
+	try
+	{
+		if (id<0 || static_cast<size_t>(id)>=pseudonym_names_.size())
+		{
+			throw(Tpm_error("Unknown pseudonym key"));
+		}
+		// TPMS_CERTIFY_INFO, the qualified name is not tracked so the name is used
+		Byte_buffer const& name=pseudonym_names_[id];
+		Byte_buffer cert=attest_header(TPM_ST_ATTEST_CERTIFY,c);
+		append_tpm2b(cert,name);
+		append_tpm2b(cert,name);
+
+		s=ecdaa_sign(counter,sha256_bb(c+sha256_bb(cert)),nt);
+		a_cert=std::move(cert);
+	}
+	catch (std::runtime_error &e)
+	{
+		rc=1;
+		last_error_=std::string(e.what());
+	}
+	return rc;
+}
+
+TPM_RC Software_daa::quote_and_sign(TPML_PCR_SELECTION const& pcr_sel, uint16_t counter, Byte_buffer const& c,
+                Byte_buffer& a_pcr, Byte_buffer& nt, Byte_buffer& s)
+{
+	TPM_RC rc=0;
+	try
+	{
+		// TPMS_QUOTE_INFO, only the SHA-256 bank is kept
+		Byte_buffer quote=attest_header(TPM_ST_ATTEST_QUOTE,c);
+		Byte_buffer pcr_values;
+		append_uint32(quote,pcr_sel.count);
+		for (uint32_t i=0;i<pcr_sel.count;++i)
+		{
+			TPMS_PCR_SELECTION const& sel=pcr_sel.pcrSelections[i];
+			if (sel.hash!=TPM_ALG_SHA256)
+			{
+				throw(Tpm_error("Only the SHA-256 PCR bank is available"));
+			}
+			append_uint16(quote,sel.hash);
+			quote.push_back(sel.sizeofSelect);
+			for (uint32_t j=0;j<sel.sizeofSelect;++j)
+			{
+				quote.push_back(sel.pcrSelect[j]);
+				for (uint32_t b=0;b<8;++b)
+				{
+					uint32_t pcr=8*j+b;
+					if ((sel.pcrSelect[j]&(1<<b))!=0 && pcr<software_pcr_count)
+					{
+						pcr_values+=pcrs_[pcr];
+					}
+				}
+			}
+		}
+		append_tpm2b(quote,sha256_bb(pcr_values));
+
+		s=ecdaa_sign(counter,sha256_bb(c+sha256_bb(quote)),nt);
+		a_pcr=std::move(quote);
+	}
+	catch (std::runtime_error &e)
+	{
+		rc=1;
+		last_error_=std::string(e.what());
+	}
+	return rc;
+}
+
+void Software_daa::pcr_extend(uint32_t pcr, Byte_buffer const& digest)
+{
+	if (pcr>=software_pcr_count)
+	{
+		throw(Tpm_error("PCR number out of range"));
+	}
+	pcrs_[pcr]=sha256_bb(pcrs_[pcr]+digest);
+}
+
+std::string Software_daa::get_last_error()
+{
+	// Move the contents of last_error also clears the value
+	std::string error(std::move(last_error_));
+
+	return error;
+}
+
+// The ECDAA signature (new form): n_T is random, T=H(n_T||digest) and
+// s=r+T.f, using the r from the commit, which is then discarded
+Byte_buffer Software_daa::ecdaa_sign(uint16_t counter, Byte_buffer const& digest, Byte_buffer& nt)
+{
+	auto it=commits_.find(counter);
+	if (it==commits_.end())
+	{
+		throw(Tpm_error("ECDAA sign: the commit counter is not valid"));
+	}
+	Byte_buffer r=std::move(it->second);
+	commits_.erase(it);
+
+	nt=rbg_(component_size);
+	Scalar_bnp256 t=hash_to_scalar(nt+digest);
+
+	return (Scalar_bnp256(r)+t*Scalar_bnp256(daa_sk_)).to_byte_buffer();
+}
+
+// The TPMS_ATTEST fields before the attested data
+Byte_buffer Software_daa::attest_header(uint16_t type, Byte_buffer const& c)
+{
+	Byte_buffer att;
+	append_uint32(att,TPM_GENERATED_VALUE);
+	append_uint16(att,type);
+	append_tpm2b(att,daa_name_);	// qualifiedSigner
+	append_tpm2b(att,c);			// extraData
+	append_uint64(att,++clock_);	// clockInfo
+	append_uint32(att,0);
+	append_uint32(att,0);
+	att.push_back(1);
+	append_uint64(att,0);			// firmwareVersion
+
+	return att;
+}
@@ -77,6 +77,10 @@ public:
 	bool check_daa_signature(bool new_daa_signature, Byte_buffer const& c_key, Daa_signature const& sig);
 	Issuer_public_keys get_public_keys() const {return pk_;}	
 	std::pair<Credential_data, Byte_buffer> make_full_credential();
+	// These use the applicant's data and random number generator that are
+	// passed in, not the issuer's, so can be called from several threads
+	Credential_data make_credential_data(Daa_applicant_data& appl, Random_byte_generator& rbg) const;
+	std::pair<Credential_data, Byte_buffer> make_full_credential(Daa_applicant_data& appl, Random_byte_generator& rbg) const;
 
 private:
 	// Secret keys x and y
@@ -95,5 +99,5 @@ private:
 #pragma GCC diagnostic ignored "-Wpedantic"
 	Daa_applicant_data appl_;
 #pragma GCC diagnostic pop
-	std::pair<Daa_credential,Daa_credential_signature> make_daa_credential();
+	std::pair<Daa_credential,Daa_credential_signature> make_daa_credential(Daa_applicant_data const& appl, Random_byte_generator& rbg) const;
 };
@@ -0,0 +1,96 @@
+/*******************************************************************************
+* File:        Daa_signer.h
+* Description: The interface to the DAA signing operations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <string>
+#include "Tss_includes.h"
+#include "Byte_buffer.h"
+#include "Tpm2_commit.h"
+
+/**
+ * The Daa_signer class is the interface to the operations that use the DAA key: TPM2_Commit
+ * followed by an ECDAA signature, a key certification or a PCR quote. Tpm_daa implements this
+ * with a TPM, Software_daa implements the same calculations in software. The parameters and
+ * results are described in Tpm_daa.
+ *
+ */
+class Daa_signer
+{
+public:
+	/**
+	 *
+	 * @return - true if the signer uses the new signature definition, false otherwise.
+	 */
+	virtual bool uses_new_daa_signature() const=0;
+	/**
+	 * Creates and loads the DAA key, returns the DAA key's public data.
+	 */
+	virtual TPM_RC create_and_load_daa_key(Byte_buffer& daa_pd)=0;
+	/**
+	 * Creates a new pseudonym key, returns its ID number and public data.
+	 */
+	virtual TPM_RC create_and_load_pseudonym_key(int& id, Byte_buffer& qps_pd)=0;
+	/**
+	 * Prepares for an ECDAA signature (TPM2_Commit).
+	 */
+	virtual TPM_RC initiate_daa_signature(Byte_buffer const& s2, Byte_buffer const& y2,
+		                                        G1_point const& pt_s, Commit_data& cd)=0;
+	/**
+	 * Hashes and signs p with an ECDAA signature.
+	 */
+	virtual TPM_RC complete_daa_signature(uint16_t counter, Byte_buffer const& p, Byte_buffer& k, Byte_buffer& w)=0;
+	/**
+	 * Certifies a pseudonym key and signs the result with an ECDAA signature.
+	 */
+	virtual TPM_RC certify_and_sign(int id, uint16_t counter, Byte_buffer const& c, Byte_buffer& a_cert,
+           Byte_buffer& nt, Byte_buffer& s)=0;
+	/**
+	 * Quotes a PCR selection and signs the result with an ECDAA signature.
+	 */
+	virtual TPM_RC quote_and_sign(TPML_PCR_SELECTION const& pcr_sel, uint16_t counter, Byte_buffer const& c,
+                            Byte_buffer& a_pcr, Byte_buffer& nt, Byte_buffer& s)=0;
+	/**
+	 * Returns the last error reported, or the empty string. The last error is cleared ready for next time.
+	 */
+	virtual std::string get_last_error()=0;
+	virtual ~Daa_signer()=default;
+};
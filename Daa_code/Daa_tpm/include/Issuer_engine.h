@@ -0,0 +1,85 @@
+/*******************************************************************************
+* File:        Issuer_engine.h
+* Description: A thread safe issuer that processes join requests concurrently
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include "Byte_buffer.h"
+#include "Make_credential.h"
+#include "Issuer_public_keys.h"
+#include "Credential_issuer.h"
+
+// Runs the issuer's side of many joins at once. Each join has its own
+// applicant data and is run by one of a pool of worker threads, each with its
+// own random number generator.
+class Issuer_engine
+{
+public:
+	// (credential data, c_hat) as returned by make_full_credential
+	using Join_result=std::pair<Credential_data,Byte_buffer>;
+
+	// number_of_threads=0 uses one thread for each core
+	explicit Issuer_engine(size_t number_of_threads=0);
+	Issuer_engine(Issuer_engine const& ie)=delete;
+	Issuer_engine& operator=(Issuer_engine const& ie)=delete;
+	// Waits for the joins that have been submitted to finish
+	~Issuer_engine();
+	// Errors, e.g. bad public data, are thrown by the future's get()
+	std::future<Join_result> submit_join(Byte_buffer const& ek, Byte_buffer const& daa_pd);
+	Issuer_public_keys get_public_keys() const {return issuer_.get_public_keys();}
+	size_t number_of_threads() const {return workers_.size();}
+
+private:
+	Credential_issuer const issuer_;
+
+	std::mutex jobs_mutex_;
+	std::condition_variable jobs_cv_;
+	std::deque<std::packaged_task<Join_result()>> jobs_;
+	bool stopping_;
+	std::vector<std::thread> workers_;
+
+	void run_worker();
+};
@@ -0,0 +1,102 @@
+/*******************************************************************************
+* File:        Software_daa.h
+* Description: A software implementation of the DAA signing operations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <string>
+#include <array>
+#include <map>
+#include <vector>
+#include "Tss_includes.h"
+#include "Byte_buffer.h"
+#include "Get_random_bytes.h"
+#include "Tpm2_commit.h"
+#include "Daa_signer.h"
+
+const size_t software_pcr_count=24;
+
+/**
+ * The Software_daa class does the TPM's DAA calculations in software, so that large numbers
+ * of signatures, certifications and quotes can be made without a TPM. The DAA key and the
+ * pseudonym keys are held in memory, the key's public data and the attestation data have the
+ * TPM's format. It is for testing only, the keys are not protected.
+ *
+ */
+class Software_daa : public Daa_signer
+{
+public:
+	Software_daa();
+	Software_daa(Software_daa const& t)=delete;
+	Software_daa& operator=(Software_daa const& t)=delete;
+	bool uses_new_daa_signature() const override {return true;}
+	TPM_RC create_and_load_daa_key(Byte_buffer& daa_pd) override;
+	TPM_RC create_and_load_pseudonym_key(int& id, Byte_buffer& qps_pd) override;
+	TPM_RC initiate_daa_signature(Byte_buffer const& s2, Byte_buffer const& y2,
+		                                        G1_point const& pt_s, Commit_data& cd) override;
+	TPM_RC complete_daa_signature(uint16_t counter, Byte_buffer const& p, Byte_buffer& k, Byte_buffer& w) override;
+	TPM_RC certify_and_sign(int id, uint16_t counter, Byte_buffer const& c, Byte_buffer& a_cert,
+           Byte_buffer& nt, Byte_buffer& s) override;
+	TPM_RC quote_and_sign(TPML_PCR_SELECTION const& pcr_sel, uint16_t counter, Byte_buffer const& c,
+                            Byte_buffer& a_pcr, Byte_buffer& nt, Byte_buffer& s) override;
+	/**
+	 * Extends one of the software PCRs (SHA-256 bank), as TPM2_PCR_Extend.
+	 *
+	 * @param[in] pcr - the PCR number.
+	 * @param[in] digest - the digest to extend the PCR with.
+	 */
+	void pcr_extend(uint32_t pcr, Byte_buffer const& digest);
+	std::string get_last_error() override;
+	~Software_daa()=default;
+
+private:
+	Random_byte_generator rbg_;
+	Byte_buffer daa_sk_;
+	Byte_buffer daa_name_;
+	uint16_t commit_count_;
+	std::map<uint16_t,Byte_buffer> commits_;	// counter -> r, each may only be used once
+	std::vector<Byte_buffer> pseudonym_names_;
+	std::array<Byte_buffer,software_pcr_count> pcrs_;
+	uint64_t clock_;
+	std::string last_error_;
+
+	Byte_buffer ecdaa_sign(uint16_t counter, Byte_buffer const& digest, Byte_buffer& nt);
+	Byte_buffer attest_header(uint16_t type, Byte_buffer const& c);
+};
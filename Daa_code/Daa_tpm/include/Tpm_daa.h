@@ -55,12 +55,14 @@
 #include "Byte_buffer.h"
 #include "Tpm2_commit.h"
 #include "Tpm_defs.h"
+#include "Daa_signer.h"
 
 /**
  * The Tpm_daa class, implements the calls needed for the VANET DAA protocol. Details of the protocol are given separately.
+ * The signing operations are those of the Daa_signer interface.
  *
  */
-class Tpm_daa
+class Tpm_daa : public Daa_signer
 {
 public:
     using Tpm_revision_data=std::array<uint32_t,3>;
@@ -95,7 +97,7 @@ public:
 	 *
 	 * @return - true if the TPM uses the new signature definition, false otherwise.
 	 */
-	bool uses_new_daa_signature() const;
+	bool uses_new_daa_signature() const override;
 	/**
 	 * Returns the endorsement key's public data.
 	 *
@@ -109,7 +111,7 @@ public:
 	 * @param[out] daa_pd  - the DAA key's public data.
  	 * @return TPM_RC - this will be zero for a successful call. If non-zero use get_last_error() to return the error.
 	 */
-	TPM_RC create_and_load_daa_key(Byte_buffer& daa_pd);
+	TPM_RC create_and_load_daa_key(Byte_buffer& daa_pd) override;
     /**
 	 * Installs and loads a key from Key_data, used when the key has been saved and retieved then for
      * futher operations. The key is loaded to ensure that it is a key from the TPM
@@ -143,7 +145,7 @@ public:
 	 * @param[out] qps_pd - the new pseudonym key's public data.
  	 * @return TPM_RC - this will be zero for a successful call. If non-zero use get_last_error() to return the error.
 	 */
-	TPM_RC create_and_load_pseudonym_key(int& id, Byte_buffer& qps_pd);
+	TPM_RC create_and_load_pseudonym_key(int& id, Byte_buffer& qps_pd) override;
     /**
 	 * Retrieves the key data for a pseudonym key.
 	 *
@@ -165,7 +167,7 @@ public:
  	 * @return TPM_RC - this will be zero for a successful call. If non-zero use get_last_error() to return the error.
 	 */
 	TPM_RC initiate_daa_signature(Byte_buffer const& s2, Byte_buffer const& y2,
-		                                        G1_point const& pt_s, Commit_data& cd);
+		                                        G1_point const& pt_s, Commit_data& cd) override;
 	/**
 	 * Completes the ECDAA signature, first calling TPM2_Hash to generate the digest to be signed using TPM2_sign.
 	 * 
@@ -175,7 +177,7 @@ public:
 	 * @param[out] w - the w value from ECDAA sign.
  	 * @return TPM_RC - this will be zero for a successful call. If non-zero use get_last_error() to return the error.
 	 */
-	TPM_RC complete_daa_signature(uint16_t counter, Byte_buffer const& p, Byte_buffer& k, Byte_buffer& w);
+	TPM_RC complete_daa_signature(uint16_t counter, Byte_buffer const& p, Byte_buffer& k, Byte_buffer& w) override;
 	/**
 	 * Certifies a pseudonym key and signs the result with an ECDAA signature.
 	 * 
@@ -188,7 +190,7 @@ public:
  	 * @return TPM_RC - this will be zero for a successful call. If non-zero use get_last_error() to return the error.
 	 */
 	TPM_RC certify_and_sign(int id, uint16_t counter, Byte_buffer const& c, Byte_buffer& a_cert,
-           Byte_buffer& nt, Byte_buffer& s);
+           Byte_buffer& nt, Byte_buffer& s) override;
     /**
 	 * Obtains the PCR quote result for a PCR selection and signs the result with an ECDAA signature.
 	 * 
@@ -201,7 +203,7 @@ public:
  	 * @return TPM_RC - this will be zero for a successful call. If non-zero use get_last_error() to return the error.
 	 */
 	TPM_RC quote_and_sign(TPML_PCR_SELECTION const& pcr_sel, uint16_t counter, Byte_buffer const& c,
-                            Byte_buffer& a_pcr, Byte_buffer& nt, Byte_buffer& s);
+                            Byte_buffer& a_pcr, Byte_buffer& nt, Byte_buffer& s) override;
 	/**
 	 * Returns the TSS_CONTEXT pointer. Only used for testing, particularly with the TPM simulator..
 	 *
@@ -213,7 +215,7 @@ public:
 	 *
 	 * @return - a string containing the last error that was reported.
 	 */
-	std::string get_last_error();
+	std::string get_last_error() override;
 	/**
 	 * The destructor - tidies up. In particular flushing all of the transient keys from the TPM and doing an orderly shutdown.
 	 *
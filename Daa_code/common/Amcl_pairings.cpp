@@ -44,6 +44,9 @@
 #include "Daa_credential.h"
 #include "Amcl_pairings.h"
 
+using namespace FP256BN;
+using namespace FP256BN_BIG;
+
 Issuer_public_keys amcl_calculate_public_keys(Issuer_private_keys const& pks)
 {
     using namespace FP256BN;
@@ -74,77 +77,385 @@ Issuer_public_keys amcl_calculate_public_keys(Issuer_private_keys const& pks)
     ECP2_mul(&ecp2_y,y);
     G2_point pk_y=g2_point_from_bb(ecp2_to_bb(&ecp2_y));
 
-	if (log_ptr->debug_level()>1)
+	LOG_DEBUG(2,"  P2: {}",ecp2_to_bb(&p2));
+	LOG_DEBUG(2,"pk_x: {}",ecp2_to_bb(&ecp2_x));
+	LOG_DEBUG(2,"pk_y: {}",ecp2_to_bb(&ecp2_y));
+
+	return std::make_pair(pk_x,pk_y);
+}
+
+namespace
+{
+// Tangent line at A, A is then doubled. The same calculation as the AMCL
+// PAIR_line function, but with the multiplication by P's coordinates left
+// until the line is evaluated.
+void line_dbl(Line_coeffs& lc, ECP2* a)
+{
+	FP2 xx,yy,zz,yz;
+
+	FP2_copy(&xx,&(a->x));
+	FP2_copy(&yy,&(a->y));
+	FP2_copy(&zz,&(a->z));
+
+	FP2_copy(&yz,&yy);
+	FP2_mul(&yz,&yz,&zz);
+	FP2_sqr(&xx,&xx);
+	FP2_sqr(&yy,&yy);
+	FP2_sqr(&zz,&zz);
+
+	FP2_imul(&yz,&yz,4);
+	FP2_neg(&yz,&yz);
+	FP2_norm(&yz);          // -4YZ
+
+	FP2_imul(&xx,&xx,6);    // 6X^2
+
+	FP2_imul(&zz,&zz,3*CURVE_B_I);
+#if SEXTIC_TWIST_FP256BN==D_TYPE
+	FP2_div_ip2(&zz);
+#endif
+#if SEXTIC_TWIST_FP256BN==M_TYPE
+	FP2_mul_ip(&zz);
+	FP2_add(&zz,&zz,&zz);
+	FP2_mul_ip(&yz);
+	FP2_norm(&yz);
+#endif
+	FP2_norm(&zz);
+
+	FP2_add(&yy,&yy,&yy);
+	FP2_sub(&zz,&zz,&yy);
+	FP2_norm(&zz);          // 6b.Z^2-2Y^2
+
+	FP2_copy(&lc.cy,&yz);
+	FP2_copy(&lc.c0,&zz);
+	FP2_copy(&lc.cx,&xx);
+
+	ECP2_dbl(a);
+}
+
+// Line through A and B, A is then set to A+B
+void line_add(Line_coeffs& lc, ECP2* a, ECP2* b)
+{
+	FP2 x1,y1,t1,t2;
+
+	FP2_copy(&x1,&(a->x));
+	FP2_copy(&y1,&(a->y));
+	FP2_copy(&t1,&(a->z));
+	FP2_copy(&t2,&t1);
+
+	FP2_mul(&t1,&t1,&(b->y));  // Z1.Y2
+	FP2_mul(&t2,&t2,&(b->x));  // Z1.X2
+
+	FP2_sub(&x1,&x1,&t2);
+	FP2_norm(&x1);             // X1-Z1.X2
+	FP2_sub(&y1,&y1,&t1);
+	FP2_norm(&y1);             // Y1-Z1.Y2
+
+	FP2_copy(&t1,&x1);
+	FP2_mul(&t1,&t1,&(b->y));  // (X1-Z1.X2).Y2
+
+	FP2_copy(&t2,&y1);
+	FP2_mul(&t2,&t2,&(b->x));  // (Y1-Z1.Y2).X2
+	FP2_sub(&t2,&t2,&t1);
+	FP2_norm(&t2);
+
+#if SEXTIC_TWIST_FP256BN==M_TYPE
+	FP2_mul_ip(&x1);
+	FP2_norm(&x1);
+#endif
+	FP2_neg(&y1,&y1);
+	FP2_norm(&y1);
+
+	FP2_copy(&lc.cy,&x1);
+	FP2_copy(&lc.c0,&t2);
+	FP2_copy(&lc.cx,&y1);
+
+	ECP2_add(a,b);
+}
+
+// Evaluate the line at the affine point (px,py) and multiply it into r
+void line_eval_mul(FP12* r, Line_coeffs const& lc, FP* px, FP* py)
+{
+	FP2 ly,lx;
+	FP4 a,b,c;
+	FP12 lv;
+
+	// AMCL does not use const
+	FP2_pmul(&ly,const_cast<FP2*>(&lc.cy),py);
+	FP2_pmul(&lx,const_cast<FP2*>(&lc.cx),px);
+
+	FP4_from_FP2s(&a,&ly,const_cast<FP2*>(&lc.c0));
+#if SEXTIC_TWIST_FP256BN==D_TYPE
+	FP4_from_FP2(&b,&lx);
+	FP4_zero(&c);
+#endif
+#if SEXTIC_TWIST_FP256BN==M_TYPE
+	FP4_zero(&b);
+	FP4_from_FP2H(&c,&lx);
+#endif
+	FP12_from_FP4s(&lv,&a,&b,&c);
+	FP12_smul(r,&lv,SEXTIC_TWIST_FP256BN);
+}
+
+// The (signed) loop parameter for the optimal ate pairing, as used by AMCL
+void ate_loop_parameters(BIG& n, BIG& n3)
+{
+	BIG x;
+	BIG_rcopy(x,CURVE_Bnx);
+#if PAIRING_FRIENDLY_FP256BN==BN
+	BIG_pmul(n,x,6);
+#if SIGN_OF_X_FP256BN==POSITIVEX
+	BIG_inc(n,2);
+#else
+	BIG_dec(n,2);
+#endif
+#else
+	BIG_copy(n,x);
+#endif
+	BIG_norm(n);
+	BIG_pmul(n3,n,3);
+	BIG_norm(n3);
+}
+
+// The G1 point, in affine coordinates, and its line functions
+struct Miller_state
+{
+	Prepared_g2_point const* lines;
+	FP px;
+	FP py;
+};
+}
+
+Prepared_g2_point prepare_g2_point(ECP2* q)
+{
+	Prepared_g2_point lines;
+	if (ECP2_isinf(q))
 	{
-		log_ptr->os() << "  P2: " << ecp2_to_bb(&p2).to_hex_string() << '\n';
-		log_ptr->os() << "pk_x: " << ecp2_to_bb(&ecp2_x).to_hex_string() << '\n';
-		log_ptr->os() << "pk_y: " << ecp2_to_bb(&ecp2_y).to_hex_string() << '\n';
+		return lines;
 	}
 
-	return std::make_pair(pk_x,pk_y);
+	ECP2 qa,neg_q,a;
+	ECP2_copy(&qa,q);
+	ECP2_affine(&qa);
+	ECP2_copy(&neg_q,&qa);
+	ECP2_neg(&neg_q);
+	ECP2_copy(&a,&qa);
+
+	BIG n,n3;
+	ate_loop_parameters(n,n3);
+
+	Line_coeffs lc;
+	int nb=BIG_nbits(n3);
+	for (int i=nb-2;i>=1;i--)
+	{
+		line_dbl(lc,&a);
+		lines.push_back(lc);
+		int bt=BIG_bit(n3,i)-BIG_bit(n,i);
+		if (bt!=0)
+		{
+			line_add(lc,&a,(bt==1)?&qa:&neg_q);
+			lines.push_back(lc);
+		}
+	}
+
+#if PAIRING_FRIENDLY_FP256BN==BN
+	// R-ate fixup
+	FP fa,fb;
+	FP2 frob;
+	FP_rcopy(&fa,Fra);
+	FP_rcopy(&fb,Frb);
+	FP2_from_FPs(&frob,&fa,&fb);
+#if SEXTIC_TWIST_FP256BN==M_TYPE
+	FP2_inv(&frob,&frob);
+	FP2_norm(&frob);
+#endif
+#if SIGN_OF_X_FP256BN==NEGATIVEX
+	ECP2_neg(&a);
+#endif
+	ECP2 k;
+	ECP2_copy(&k,&qa);
+	ECP2_frob(&k,&frob);
+	line_add(lc,&a,&k);
+	lines.push_back(lc);
+	ECP2_frob(&k,&frob);
+	ECP2_neg(&k);
+	line_add(lc,&a,&k);
+	lines.push_back(lc);
+#endif
+
+	return lines;
 }
 
-bool check_daa_pairings(
-Daa_credential const& cre,
-Issuer_public_keys const& issuer_keys
-)
+void amcl_prepared_miller_loop(FP12* r, Prepared_pairing_pairs const& pairs)
 {
-	bool pairings_ok=true;
+	std::vector<Miller_state> ms;
+	ms.reserve(pairs.size());
+	for (auto const& pp : pairs)
+	{
+		// e(Q,P)=1 if either point is the point at infinity
+		if (pp.first->empty() || ECP_isinf(pp.second))
+		{
+			continue;
+		}
+		ms.emplace_back();
+		Miller_state& st=ms.back();
+		ECP p;
+		ECP_copy(&p,pp.second);
+		ECP_affine(&p);
+		FP_copy(&st.px,&(p.x));
+		FP_copy(&st.py,&(p.y));
+		st.lines=pp.first;
+	}
 
-    using namespace FP256BN;
-	using namespace FP256BN_BIG;
+	BIG n,n3;
+	ate_loop_parameters(n,n3);
 
+	// The lines are in the same order for every point in G2
+	size_t line=0;
+	FP12_one(r);
+	int nb=BIG_nbits(n3);
+	for (int i=nb-2;i>=1;i--)
+	{
+		FP12_sqr(r,r);
+		for (auto& st : ms)
+		{
+			line_eval_mul(r,(*st.lines)[line],&st.px,&st.py);
+		}
+		++line;
+		if (BIG_bit(n3,i)!=BIG_bit(n,i))
+		{
+			for (auto& st : ms)
+			{
+				line_eval_mul(r,(*st.lines)[line],&st.px,&st.py);
+			}
+			++line;
+		}
+	}
+
+#if SIGN_OF_X_FP256BN==NEGATIVEX
+	FP12_conj(r,r);
+#endif
+
+	// Any remaining lines are the R-ate fixup
+	for (auto& st : ms)
+	{
+		for (size_t l=line;l<st.lines->size();++l)
+		{
+			line_eval_mul(r,(*st.lines)[l],&st.px,&st.py);
+		}
+	}
+}
+
+void amcl_multi_miller_loop(FP12* r, Pairing_pairs const& pairs)
+{
+	std::vector<Prepared_g2_point> g2_lines;
+	g2_lines.reserve(pairs.size());
+	Prepared_pairing_pairs prepared_pairs;
+	for (auto const& pp : pairs)
+	{
+		g2_lines.push_back(prepare_g2_point(pp.first));
+		prepared_pairs.push_back(std::make_pair(&g2_lines.back(),pp.second));
+	}
+
+	amcl_prepared_miller_loop(r,prepared_pairs);
+}
+
+void amcl_multi_pairing(FP12* r, Pairing_pairs const& pairs)
+{
+	amcl_multi_miller_loop(r,pairs);
+	PAIR_fexp(r);
+}
+
+bool amcl_pairing_product_is_one(Pairing_pairs const& pairs)
+{
+	FP12 r;
+	amcl_multi_pairing(&r,pairs);
+
+	return (FP12_isunity(&r)==1);
+}
+
+bool amcl_prepared_product_is_one(Prepared_pairing_pairs const& pairs)
+{
+	FP12 r;
+	amcl_prepared_miller_loop(&r,pairs);
+	PAIR_fexp(&r);
+
+	return (FP12_isunity(&r)==1);
+}
+
+Prepared_issuer_keys::Prepared_issuer_keys(Issuer_public_keys const& ipk)
+{
 	// Generator for G2 - MUST use the generator provided and not the one
 	// from the ISO example!!
-    ECP2 p2;
+	ECP2 p2;
 	ECP2_generator(&p2);
+	p2_=prepare_g2_point(&p2);
 
-    ECP2 ecp2_x,ecp2_y;
-	bb_to_ecp2(g2_point_concat(issuer_keys.first),&ecp2_x);
-	bb_to_ecp2(g2_point_concat(issuer_keys.second),&ecp2_y);
+	ECP2 ecp2_x,ecp2_y;
+	bb_to_ecp2(g2_point_concat(ipk.first),&ecp2_x);
+	bb_to_ecp2(g2_point_concat(ipk.second),&ecp2_y);
+	x_=prepare_g2_point(&ecp2_x);
+	y_=prepare_g2_point(&ecp2_y);
+}
 
-    ECP g1_0,g1_1,g1_2,g1_3;
-    g1_point_to_ecp(cre[0],&g1_0);
-	g1_point_to_ecp(cre[1],&g1_1);
-	g1_point_to_ecp(cre[2],&g1_2);
-	g1_point_to_ecp(cre[3],&g1_3);
+bool daa_credential_to_ecps(Daa_credential const& cre, ECP pts[4])
+{
+	bool points_ok=true;
+	for (int i=0;i<4;++i)
+	{
+		g1_point_to_ecp(cre[i],&pts[i]);
+		if (ECP_isinf(&pts[i]))
+		{
+			points_ok=false;
+		}
+	}
+	return points_ok;
+}
 
-	FP12 pair_lhs,pair_rhs;
+bool check_daa_pairings(
+Daa_credential const& cre,
+Issuer_public_keys const& issuer_keys
+)
+{
+	return check_daa_pairings(cre,Prepared_issuer_keys(issuer_keys));
+}
 
-	PAIR_ate(&pair_lhs,&ecp2_y,&g1_0);
-	PAIR_fexp(&pair_lhs);
+bool check_daa_pairings(
+Daa_credential const& cre,
+Prepared_issuer_keys const& issuer_keys
+)
+{
+	bool pairings_ok=true;
 
-	PAIR_ate(&pair_rhs,&p2,&g1_1);
-	PAIR_fexp(&pair_rhs);
+	// A pairing with the point at infinity is 1, so such a point would not
+	// be checked at all
+	ECP pts[4];
+	if (!daa_credential_to_ecps(cre,pts))
+	{
+		LOG_DEBUG(1,"A credential point is at infinity or not on the curve");
+		return false;
+	}
+	ECP& g1_0=pts[0];
+	ECP& g1_1=pts[1];
+	ECP& g1_2=pts[2];
+	ECP& g1_3=pts[3];
 
-	if(!FP12_equals(&pair_lhs,&pair_rhs))
+	// e(Y,A)=e(P2,B) <=> e(Y,A).e(P2,-B)=1
+	ECP_neg(&g1_1);
+	if (!amcl_prepared_product_is_one({{&issuer_keys.y(),&g1_0},{&issuer_keys.p2(),&g1_1}}))
 	{
 		pairings_ok=false;
-		if (log_ptr->debug_level()>0)
-		{
-			log_ptr->os() << "Pairing 1 failed\n";
-		}
+		LOG_DEBUG(1,"Pairing 1 failed");
 	}
 
 	ECP_add(&g1_3,&g1_0);
-    if (log_ptr->debug_level()>0)
-    {
-        log_ptr->os() << "cre[0]+cre[3]: " << ecp_to_bb(&g1_3).to_hex_string() << std::endl;
-    }
-
-	PAIR_ate(&pair_lhs,&ecp2_x,&g1_3);
-	PAIR_fexp(&pair_lhs);
+    LOG_DEBUG(1,"cre[0]+cre[3]: {}",ecp_to_bb(&g1_3));
 
-	PAIR_ate(&pair_rhs,&p2,&g1_2);
-	PAIR_fexp(&pair_rhs);
-
-	if(!FP12_equals(&pair_lhs,&pair_rhs))
+	// e(X,A+D)=e(P2,C) <=> e(X,A+D).e(P2,-C)=1
+	ECP_neg(&g1_2);
+	if (!amcl_prepared_product_is_one({{&issuer_keys.x(),&g1_3},{&issuer_keys.p2(),&g1_2}}))
 	{
 		pairings_ok=false;
-		if (log_ptr->debug_level()>0)
-		{
-			log_ptr->os() << "Pairing 2 failed\n";
-		}
+		LOG_DEBUG(1,"Pairing 2 failed");
 	}
 
 	return pairings_ok;
@@ -0,0 +1,130 @@
+/*******************************************************************************
+* File:        Basename_cache.cpp
+* Description: A cache of the points calculated from basenames
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#include <stdexcept>
+#include "Byte_buffer.h"
+#include "Sha.h"
+#include "bnp256_param.h"
+#include "Openssl_bn_utils.h"
+#include "Openssl_ec_map_to_point.h"
+#include "Basename_cache.h"
+
+Basename_cache::Basename_cache(size_t capacity) : capacity_(capacity), hits_(0), misses_(0)
+{
+	if (capacity_==0)
+	{
+		throw(std::runtime_error("Basename_cache: the capacity must be at least one"));
+	}
+}
+
+Basename_points Basename_cache::get(Byte_buffer const& bsn)
+{
+	if (bsn.size()==0)
+	{
+		throw(std::runtime_error("Basename_cache: the basename is empty"));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(cache_mutex_);
+		auto it=index_.find(bsn);
+		if (it!=index_.end())
+		{
+			++hits_;
+			lru_.splice(lru_.begin(),lru_,it->second);
+			return it->second->second;
+		}
+		++misses_;
+	}
+
+	// Calculated without the lock, so a miss does not hold up other basenames.
+	// Two threads missing on the same basename get the same points.
+	Basename_points bp;
+	bp.map_pt=point_from_basename(bsn);
+	bp.pt_j=std::make_pair(bb_mod(sha256_bb(bp.map_pt.first),bnp256_p),bp.map_pt.second);
+
+	std::lock_guard<std::mutex> lock(cache_mutex_);
+	if (index_.find(bsn)==index_.end())
+	{
+		lru_.emplace_front(bsn,bp);
+		index_[bsn]=lru_.begin();
+		if (lru_.size()>capacity_)
+		{
+			index_.erase(lru_.back().first);
+			lru_.pop_back();
+		}
+	}
+	return bp;
+}
+
+size_t Basename_cache::size() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex_);
+	return lru_.size();
+}
+
+uint64_t Basename_cache::hits() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex_);
+	return hits_;
+}
+
+uint64_t Basename_cache::misses() const
+{
+	std::lock_guard<std::mutex> lock(cache_mutex_);
+	return misses_;
+}
+
+void Basename_cache::clear()
+{
+	std::lock_guard<std::mutex> lock(cache_mutex_);
+	lru_.clear();
+	index_.clear();
+	hits_=0;
+	misses_=0;
+}
+
+Basename_cache& basename_cache()
+{
+	// Initialisation of a local static is thread safe
+	static Basename_cache cache;
+	return cache;
+}
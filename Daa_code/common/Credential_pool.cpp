@@ -0,0 +1,145 @@
+/*******************************************************************************
+* File:        Credential_pool.cpp
+* Description: A pool of pre-randomised DAA credentials for signing
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#include <stdexcept>
+#include "Daa_credential.h"
+#include "Credential_pool.h"
+
+Credential_pool::Credential_pool(
+Daa_credential const& cre,
+size_t capacity,
+Pool_refill refill
+) :
+cre_(cre), capacity_(capacity), refill_(refill), stopping_(false), produced_(0), taken_(0), misses_(0),
+refill_time_(std::chrono::steady_clock::duration::zero())
+{
+	if (capacity_==0)
+	{
+		throw(std::runtime_error("Credential_pool: the capacity must be at least one"));
+	}
+	refiller_=std::thread(&Credential_pool::run_refill,this);
+}
+
+Credential_pool::~Credential_pool()
+{
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex_);
+		stopping_=true;
+	}
+	refill_cv_.notify_all();
+	refiller_.join();
+}
+
+Daa_credential Credential_pool::take(Random_byte_generator& rbg)
+{
+	{
+		std::lock_guard<std::mutex> lock(pool_mutex_);
+		++taken_;
+		if (!pool_.empty())
+		{
+			Daa_credential r_cre=pool_.front();
+			pool_.pop_front();
+			refill_cv_.notify_one();
+			return r_cre;
+		}
+		++misses_;
+	}
+	return randomise_daa_credential(cre_,rbg);
+}
+
+void Credential_pool::wait_until_full()
+{
+	std::unique_lock<std::mutex> lock(pool_mutex_);
+	full_cv_.wait(lock,[this]{return stopping_ || pool_.size()>=capacity_;});
+}
+
+Credential_pool::Metrics Credential_pool::metrics() const
+{
+	std::lock_guard<std::mutex> lock(pool_mutex_);
+	Metrics m;
+	m.depth=pool_.size();
+	m.capacity=capacity_;
+	m.produced=produced_;
+	m.taken=taken_;
+	m.misses=misses_;
+	float secs=std::chrono::duration<float>(refill_time_).count();
+	m.refill_per_sec=(secs>0)?produced_/secs:0;
+	return m;
+}
+
+void Credential_pool::run_refill()
+{
+	// The thread has its own generator, a generator is not thread safe
+	Random_byte_generator rbg;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(pool_mutex_);
+			refill_cv_.wait(lock,[this]{return stopping_ || pool_.size()<capacity_;});
+			if (stopping_)
+			{
+				return;
+			}
+		}
+
+		// Randomise without holding the lock, so takes are not held up. A
+		// failed calculation is retried by randomise_daa_credential
+		auto start=std::chrono::steady_clock::now();
+		Daa_credential r_cre=randomise_daa_credential(cre_,rbg);
+		auto dur=std::chrono::steady_clock::now()-start;
+
+		{
+			std::lock_guard<std::mutex> lock(pool_mutex_);
+			pool_.push_back(r_cre);
+			++produced_;
+			refill_time_+=dur;
+			if (pool_.size()>=capacity_)
+			{
+				if (refill_==Pool_refill::once)
+				{
+					stopping_=true;
+				}
+				full_cv_.notify_all();
+			}
+		}
+	}
+}
@@ -39,6 +39,8 @@
 *******************************************************************************/
 
 
+#include <vector>
+#include <algorithm>
 #include "Tpm_error.h"
 #include "Mechanism_4_data.h"
 #include "Get_random_bytes.h"
@@ -47,44 +49,47 @@
 #include "Sha.h"
 #include "Daa_credential.h"
 #include "bnp256_param.h"
+#include "Scalar_bnp256.h"
+#include "Curve_backend.h"
 
 
 std::pair<Daa_credential,Daa_credential_signature> generate_and_sign_daa_credential(G1_point const& daa_key, Random_byte_generator& rbg)
 {
-    size_t random_bytes=daa_key.first.size();
-
-    Ec_group_ptr ecgrp=new_ec_group("bnp256");
-    if (ecgrp==NULL)
+    Curve::G1 q_ecp;
+    try
     {
-        throw(Tpm_error("Error generating the BN_P256 curve"));
+        q_ecp=Curve::G1(daa_key);
     }
-
-    if (!point_is_on_curve(ecgrp,daa_key))
+    catch(std::runtime_error const&)
     {
         throw(Tpm_error("DAA key is not on the curve"));
     }
 
-
     Byte_buffer x=iso_sk_x;
-    Byte_buffer y=iso_sk_y;
+    Scalar_bnp256 y(iso_sk_y);
 
     Daa_credential cre;
-    Byte_buffer ry;
+    Scalar_bnp256 ry;
     G1_point p1= std::make_pair(bnp256_gX,bnp256_gY); // Generator
+    Curve::G1_prepared q_s(q_ecp);  // Q_s is used for D and R_D
     bool cre_ok=false;
     while (!cre_ok)
     {
         cre_ok=true;
         try
         {
-            Byte_buffer r=bb_mod(rbg(random_bytes),bnp256_order);
-            cre[0]=ec_point_mul(ecgrp,r,p1);        // A
-            cre[1]=ec_point_mul(ecgrp,y,cre[0]);    // B
-            ry=bb_mod_mul(r,y,bnp256_order);
-            cre[3]=ec_point_mul(ecgrp,ry,daa_key);  // D
-            cre[2]=ec_point_mul(ecgrp,x,ec_point_add(ecgrp,cre[0],cre[3])); // C
+            Scalar_bnp256 r=random_scalar_mod_n(rbg);
+            ry=r*y;
+            Byte_buffer r_bb=r.to_byte_buffer();
+            Byte_buffer ry_bb=ry.to_byte_buffer();
+            Curve::G1 pt_a=Curve::generator_mul(r_bb);  // A=[r]P_1
+            Curve::G1 pt_b=Curve::generator_mul(ry_bb); // B=[y]A=[ry]P_1
+            Curve::G1 pt_d=q_s.mul(ry_bb);              // D=[ry]Q_s
+            Curve::G1 pt_c=x*(pt_a+pt_d);               // C=[x](A+D)
+            auto pts=Curve::batch_to_g1_points({pt_a,pt_b,pt_c,pt_d});
+            std::copy(pts.begin(),pts.end(),cre.begin());
         }
-        catch(Openssl_error const& e)
+        catch(std::runtime_error const& e)
         {
             std::cout << "Credential calculation failed: " << e.what() << ", so trying again\n";
             cre_ok=false;   // A calculation failed, so try again
@@ -93,44 +98,43 @@ std::pair<Daa_credential,Daa_credential_signature> generate_and_sign_daa_credent
 
     Daa_credential_signature sig;
 
-    Byte_buffer nl=bb_mod(rbg(random_bytes),bnp256_order);
-    G1_point r_b=ec_point_mul(ecgrp,nl,p1); // R_B
-    G1_point r_d=ec_point_mul(ecgrp,nl,daa_key); // R_D
+    Scalar_bnp256 nl=random_scalar_mod_n(rbg);
+    Byte_buffer nl_bb=nl.to_byte_buffer();
+    auto r_pts=Curve::batch_to_g1_points({Curve::generator_mul(nl_bb),q_s.mul(nl_bb)});
+    G1_point const& r_b=r_pts[0];   // R_B
+    G1_point const& r_d=r_pts[1];   // R_D
 
     Byte_buffer h_str=g1_point_concat(p1)+g1_point_concat(daa_key)+g1_point_concat(r_b)+g1_point_concat(r_d);
-    sig[0]=bb_mod(sha256_bb(h_str),bnp256_order);
-    sig[1]=bb_signature_calc(nl,ry,sig[0],bnp256_order);
+    Scalar_bnp256 u=hash_to_scalar(h_str);
+    sig[0]=u.to_byte_buffer();
+    sig[1]=(nl+ry*u).to_byte_buffer();
 
     return std::make_pair(cre,sig);
 }
 
 Daa_credential randomise_daa_credential(Daa_credential const& dc, Random_byte_generator& rbg)
 {
-    size_t nonce_bytes=dc[0].first.size();
-
-    Ec_group_ptr ecgrp=new_ec_group("bnp256"); // Name ignored at the moment
-    if (ecgrp==NULL)
-    {
-        throw(Tpm_error("Error generating the BN_P256 curve"));
-    }
-
     Daa_credential r_cre;
     bool cre_ok=false;
     while (!cre_ok)
     {
         cre_ok=true;
-        Byte_buffer l=bb_mod(rbg(nonce_bytes),bnp256_order);
-        for (int i=0;i<dc.size();++i)
+        Byte_buffer l=random_scalar_mod_n(rbg).to_byte_buffer();
+        try
         {
-            try
-            {
-                r_cre[i]=ec_point_mul(ecgrp,l,dc[i]); // 0-R, 1-S, 2-T, 3-W
-            }
-            catch(Openssl_error const& e)
+            // The prepared multiplication leaves the points in projective
+            // form, so the four points share one field inversion
+            std::vector<Curve::G1> pts;
+            for (auto const& pt : dc)
             {
-                cre_ok=false;   // a calculation failed, so try again 
-                break;
+                pts.push_back(Curve::G1_prepared(Curve::G1(pt)).mul(l)); // 0-R, 1-S, 2-T, 3-W
             }
+            auto r_pts=Curve::batch_to_g1_points(pts);
+            std::copy(r_pts.begin(),r_pts.end(),r_cre.begin());
+        }
+        catch(std::runtime_error const& e)
+        {
+            cre_ok=false;   // a calculation failed, so try again 
         }
     }
 
@@ -140,6 +144,7 @@ Daa_credential randomise_daa_credential(Daa_credential const& dc, Random_byte_ge
 Byte_buffer daa_credential_concat(Daa_credential const& cre)
 {
     Byte_buffer tmp_bb;
+    tmp_bb.reserve(cre.size()*g1_affine_point_size);
     for (int i=0;i<4;++i)
     {
         tmp_bb+=g1_point_concat(cre[i]);
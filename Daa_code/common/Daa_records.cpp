@@ -0,0 +1,159 @@
+/*******************************************************************************
+* File:        Daa_records.cpp
+* Description: Reads and checks the signature and attestation records written by the DAA programs
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <stdexcept>
+#include <string>
+#include "Byte_buffer.h"
+#include "Sha.h"
+#include "Logging.h"
+#include "Model_hashes.h"
+#include "Scalar_bnp256.h"
+#include "Basename_cache.h"
+#include "Daa_records.h"
+#include "Curve_backend.h"
+
+namespace
+{
+Byte_buffer read_field(std::istream& is, std::string const& name)
+{
+    Byte_buffer bb;
+    is >> bb;
+    if (bb.size()==0)
+    {
+        throw(std::runtime_error("Incomplete record: no "+name));
+    }
+    return bb;
+}
+
+void read_basename_points(std::istream& is, Byte_buffer& bsn, G1_point& pt_j, G1_point& pt_k)
+{
+    bsn=read_field(is,"basename");
+    pt_j=g1_point_deserialise(read_field(is,"J"));
+    pt_k=g1_point_deserialise(read_field(is,"K"));
+}
+}
+
+Daa_signature_record read_daa_signature_record(
+std::istream& is,
+bool use_basename,
+Byte_buffer& serialised_ipk
+)
+{
+    Daa_signature_record rec;
+    std::string type;
+    std::string msg;
+    getline(is,type);
+    if (type!="sign")
+    {
+        throw(std::runtime_error("Not a signature record: "+type));
+    }
+    getline(is,msg);
+    rec.msg_digest=sha256_bb(Byte_buffer(msg));
+    serialised_ipk=read_field(is,"issuer public keys");
+    if (use_basename)
+    {
+        read_basename_points(is,rec.bsn,rec.pt_j,rec.pt_k);
+    }
+    rec.r_cre=deserialise_daa_credential(read_field(is,"credential"));
+    rec.sig[0]=read_field(is,"n_M");
+    rec.sig[1]=read_field(is,"s");
+    rec.sig[2]=read_field(is,"h_2");
+    return rec;
+}
+
+Daa_attestation_record read_daa_attestation_record(
+std::istream& is,
+bool use_basename,
+Byte_buffer& serialised_ipk
+)
+{
+    Daa_attestation_record rec;
+    getline(is,rec.type);
+    if (rec.type!="certify" && rec.type!="quote")
+    {
+        throw(std::runtime_error("Not an attestation record: "+rec.type));
+    }
+    rec.label=read_field(is,"label");
+    rec.key_pd=read_field(is,"key public data");
+    rec.cert=read_field(is,"attestation data");
+    serialised_ipk=read_field(is,"issuer public keys");
+    if (use_basename)
+    {
+        read_basename_points(is,rec.bsn,rec.pt_j,rec.pt_k);
+    }
+    rec.r_cre=deserialise_daa_credential(read_field(is,"credential"));
+    rec.nc=read_field(is,"n_C");
+    rec.sig_s=read_field(is,"s");
+    rec.h2=read_field(is,"h_2");
+    return rec;
+}
+
+bool verify_daa_attestation_hash(Daa_attestation_record const& rec)
+{
+    try
+    {
+        G1_point l_prime_bb;
+        if (rec.bsn.size()!=0)
+        {
+            if (rec.pt_j!=basename_cache().get(rec.bsn).pt_j)
+            {
+                LOG_DEBUG(1,"verify_daa_attestation_hash: J != J'");
+                return false;
+            }
+            // L'=[s]J-[h_2]K
+            l_prime_bb=Curve::multi_mul({rec.sig_s,rec.h2},{Curve::G1(rec.pt_j),-Curve::G1(rec.pt_k)}).to_g1_point();
+        }
+        // E'=[s]S-[h_2]W
+        G1_point e_prime_bb=Curve::multi_mul({rec.sig_s,rec.h2},{Curve::G1(rec.r_cre[1]),-Curve::G1(rec.r_cre[3])}).to_g1_point();
+
+        Byte_buffer v_c=sign_c(rec.label,rec.r_cre,rec.pt_j,rec.pt_k,l_prime_bb,e_prime_bb);
+
+        Byte_buffer h1_prime=Transcript().add(v_c).add(sha256_bb(rec.cert)).digest();
+        Byte_buffer h2_prime=Transcript().add(rec.nc).add(h1_prime).to_scalar().to_byte_buffer();
+
+        return (h2_prime==rec.h2);
+    }
+    catch (std::runtime_error const& e)
+    {
+        LOG_DEBUG(1,"verify_daa_attestation_hash: {}",e.what());
+    }
+
+    return false;
+}
@@ -0,0 +1,375 @@
+/*******************************************************************************
+* File:        Daa_stream_verifier.cpp
+* Description: Verifies a stream of DAA signature and attestation records
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include "Byte_buffer.h"
+#include "Logging.h"
+#include "Issuer_public_keys.h"
+#include "Daa_records.h"
+#include "Daa_wire_format.h"
+#include "Amcl_pairings.h"
+#include "Daa_stream_verifier.h"
+
+namespace
+{
+const size_t max_header_size=256;
+const size_t max_record_size=1<<20;
+// submit() waits when there are this many records queued for each worker
+const size_t max_queued_for_each_worker=4;
+const size_t max_prepared_issuers=8;
+}
+
+bool Frame_reader::fill()
+{
+	if (pos_!=0)
+	{
+		buf_.erase(0,pos_);
+		pos_=0;
+	}
+	char chunk[4096];
+	ssize_t n;
+	do
+	{
+		n=read(fd_,chunk,sizeof(chunk));
+	} while (n<0 && errno==EINTR);
+	if (n<0)
+	{
+		throw(std::runtime_error(std::string("Frame_reader: read failed: ")+std::strerror(errno)));
+	}
+	buf_.append(chunk,n);
+	return n!=0;
+}
+
+bool Frame_reader::next(Verify_request& req)
+{
+	size_t eol;
+	while (true)
+	{
+		eol=buf_.find('\n',pos_);
+		if (eol==pos_)
+		{
+			++pos_;		// Blank lines between frames are ignored
+			continue;
+		}
+		if (eol!=std::string::npos)
+			break;
+
+		if (buf_.size()-pos_>max_header_size)
+		{
+			throw(std::runtime_error("Frame_reader: the header is too long"));
+		}
+		if (!fill())
+		{
+			if (buf_.find_first_not_of(" \r\t",pos_)==std::string::npos)
+				return false;
+
+			throw(std::runtime_error("Frame_reader: the input ended in a header"));
+		}
+	}
+
+	std::istringstream header(buf_.substr(pos_,eol-pos_));
+	pos_=eol+1;
+	std::string type;
+	std::string bsn;
+	size_t length;
+	if (!(header >> req.id >> type))
+	{
+		throw(std::runtime_error("Frame_reader: badly formed header"));
+	}
+	req.format=(type=="wire")?Record_format::wire:Record_format::text;
+	if (req.format==Record_format::wire)
+	{
+		if (!(header >> length))
+		{
+			throw(std::runtime_error("Frame_reader: badly formed header"));
+		}
+		req.type=Record_type::signature;
+		req.use_basename=false;
+	}
+	else if (!(header >> bsn >> length))
+	{
+		throw(std::runtime_error("Frame_reader: badly formed header"));
+	}
+	else if (type=="sign")
+	{
+		req.type=Record_type::signature;
+	}
+	else if (type=="certify")
+	{
+		req.type=Record_type::certify;
+	}
+	else if (type=="quote")
+	{
+		req.type=Record_type::quote;
+	}
+	else
+	{
+		throw(std::runtime_error("Frame_reader: unknown record type: "+type));
+	}
+	if (req.format==Record_format::text)
+	{
+		if (bsn!="bsn" && bsn!="no_bsn")
+		{
+			throw(std::runtime_error("Frame_reader: expected bsn or no_bsn, not: "+bsn));
+		}
+		req.use_basename=(bsn=="bsn");
+	}
+	if (length>max_record_size)
+	{
+		throw(std::runtime_error("Frame_reader: the record is too long"));
+	}
+
+	while (buf_.size()-pos_<length)
+	{
+		if (!fill())
+		{
+			throw(std::runtime_error("Frame_reader: the input ended in a record"));
+		}
+	}
+	req.body=buf_.substr(pos_,length);
+	pos_+=length;
+	return true;
+}
+
+void Result_writer::expect()
+{
+	std::lock_guard<std::mutex> lock(writer_mutex_);
+	++pending_;
+}
+
+void Result_writer::write(std::string const& id, std::string const& failure)
+{
+	std::string line=id+(failure.empty()?" ok":" failed "+failure);
+	std::replace(line.begin(),line.end(),'\n',' ');
+	line+='\n';
+	{
+		std::lock_guard<std::mutex> lock(writer_mutex_);
+		// A reader that has gone away does not stop the verifier
+		size_t written=0;
+		while (written<line.size())
+		{
+			ssize_t n=::write(fd_,line.data()+written,line.size()-written);
+			if (n<0 && errno==EINTR)
+				continue;
+			if (n<=0)
+				break;
+			written+=n;
+		}
+		--pending_;
+	}
+	writer_cv_.notify_all();
+}
+
+void Result_writer::wait_for_results()
+{
+	std::unique_lock<std::mutex> lock(writer_mutex_);
+	writer_cv_.wait(lock,[this]{return pending_==0;});
+}
+
+Stream_verifier::Stream_verifier(size_t number_of_threads, Attestation_data_check check) : check_(check), stopping_(false), stats_{0,0,0}
+{
+	if (number_of_threads==0)
+	{
+		number_of_threads=std::max(1U,std::thread::hardware_concurrency());
+	}
+	for (size_t i=0;i<number_of_threads;++i)
+	{
+		workers_.emplace_back(&Stream_verifier::run_worker,this);
+	}
+}
+
+Stream_verifier::~Stream_verifier()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobs_mutex_);
+		stopping_=true;
+	}
+	jobs_cv_.notify_all();
+	for (auto& w : workers_)
+	{
+		w.join();
+	}
+}
+
+void Stream_verifier::submit(Verify_request req, std::shared_ptr<Result_writer> const& writer)
+{
+	writer->expect();
+	std::function<void()> job=[this,req,writer]()
+	{
+		std::string failure;
+		try
+		{
+			failure=verify(req);
+		}
+		catch (std::exception const& e)
+		{
+			failure=e.what();
+		}
+		{
+			std::lock_guard<std::mutex> lock(jobs_mutex_);
+			if (failure.empty())
+			{
+				++stats_.verified;
+			}
+			else
+			{
+				++stats_.failed;
+			}
+		}
+		writer->write(req.id,failure);
+	};
+	{
+		std::unique_lock<std::mutex> lock(jobs_mutex_);
+		space_cv_.wait(lock,[this]{return jobs_.size()<max_queued_for_each_worker*workers_.size();});
+		jobs_.push_back(std::move(job));
+		++stats_.requests;
+	}
+	jobs_cv_.notify_one();
+}
+
+Stream_verifier_stats Stream_verifier::stats() const
+{
+	std::lock_guard<std::mutex> lock(jobs_mutex_);
+	return stats_;
+}
+
+std::string Stream_verifier::verify(Verify_request const& req)
+{
+	if (req.format==Record_format::wire)
+	{
+		// The fields are read in place from the request's body
+		Daa_wire_record rec=parse_daa_wire_record(reinterpret_cast<Byte_const_ptr>(req.body.data()),req.body.size());
+		auto keys=[this,&rec]{
+			return prepared_issuer_keys(Byte_buffer(rec.issuer_keys),[&rec]{return wire_issuer_public_keys(rec.issuer_keys);});
+		};
+		if (rec.type==Daa_wire_type::sign)
+			return verify_signature(wire_to_signature_record(rec),keys);
+
+		if (rec.type==Daa_wire_type::certify || rec.type==Daa_wire_type::quote)
+			return verify_attestation(wire_to_attestation_record(rec),keys);
+
+		return "not a signature or attestation record";
+	}
+
+	std::istringstream is(req.body);
+	Byte_buffer serialised_ipk;
+	auto keys=[this,&serialised_ipk]{
+		return prepared_issuer_keys(serialised_ipk,[&serialised_ipk]{return deserialise_issuer_public_keys(serialised_ipk);});
+	};
+	if (req.type==Record_type::signature)
+		return verify_signature(read_daa_signature_record(is,req.use_basename,serialised_ipk),keys);
+
+	Daa_attestation_record rec=read_daa_attestation_record(is,req.use_basename,serialised_ipk);
+	std::string expected_type=(req.type==Record_type::certify)?"certify":"quote";
+	if (rec.type!=expected_type)
+		return "expected a "+expected_type+" record, but found "+rec.type;
+
+	return verify_attestation(rec,keys);
+}
+
+std::string Stream_verifier::verify_signature(Daa_signature_record const& rec, std::function<Issuer_keys_ptr()> const& keys)
+{
+	if (!verify_daa_signature_hash(rec))
+		return "signature check failed";
+
+	if (!check_daa_pairings(rec.r_cre,*keys()))
+		return "credential pairings check failed";
+
+	return "";
+}
+
+std::string Stream_verifier::verify_attestation(Daa_attestation_record const& rec, std::function<Issuer_keys_ptr()> const& keys)
+{
+	if (!check_ || !check_(rec))
+		return rec.type+" attestation data check failed";
+
+	if (!verify_daa_attestation_hash(rec))
+		return rec.type+" signature check failed";
+
+	if (!check_daa_pairings(rec.r_cre,*keys()))
+		return "credential pairings check failed";
+
+	return "";
+}
+
+Stream_verifier::Issuer_keys_ptr Stream_verifier::prepared_issuer_keys(Byte_buffer const& serialised_ipk, std::function<Issuer_public_keys()> const& decode)
+{
+	{
+		std::lock_guard<std::mutex> lock(keys_mutex_);
+		auto it=issuer_keys_.find(serialised_ipk);
+		if (it!=issuer_keys_.end())
+			return it->second;
+	}
+
+	// Prepared without the lock, two threads may both prepare a new issuer's keys
+	Issuer_keys_ptr keys=std::make_shared<Prepared_issuer_keys>(decode());
+	std::lock_guard<std::mutex> lock(keys_mutex_);
+	if (issuer_keys_.size()>=max_prepared_issuers)
+	{
+		issuer_keys_.clear();
+	}
+	issuer_keys_[serialised_ipk]=keys;
+	return keys;
+}
+
+void Stream_verifier::run_worker()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(jobs_mutex_);
+			jobs_cv_.wait(lock,[this]{return stopping_ || !jobs_.empty();});
+			if (jobs_.empty())
+			{
+				return;	// Stopping, with nothing left to do
+			}
+			job=std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		space_cv_.notify_one();
+		job();
+	}
+}
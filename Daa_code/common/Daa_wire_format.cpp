@@ -0,0 +1,503 @@
+/*******************************************************************************
+* File:        Daa_wire_format.cpp
+* Description: A binary format for the DAA keys, credentials, signatures and attestations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Byte_buffer.h"
+#include "Sha.h"
+#include "G1_utils.h"
+#include "G2_utils.h"
+#include "Issuer_public_keys.h"
+#include "Daa_credential.h"
+#include "Daa_records.h"
+#include "Daa_wire_format.h"
+
+namespace
+{
+const Byte wire_magic[4]={'D','A','A','W'};
+
+void put_uint32(Byte_buffer& out, size_t n)
+{
+    if (n>0xffffffff)
+    {
+        throw(std::runtime_error("daa_wire: field too long"));
+    }
+    out+=uint32_to_bb(static_cast<uint32_t>(n));
+}
+
+uint32_t get_uint32(Byte_const_ptr p)
+{
+    return (static_cast<uint32_t>(p[0])<<24)|(static_cast<uint32_t>(p[1])<<16)|
+           (static_cast<uint32_t>(p[2])<<8)|static_cast<uint32_t>(p[3]);
+}
+
+void put_slot(Byte_buffer& out, Byte_buffer const& value)
+{
+    size_t sz=value.size();
+    if (sz>component_size)
+    {
+        throw(std::runtime_error("daa_wire: value too long for a slot"));
+    }
+    out.push_back(static_cast<Byte>(sz));
+    for (size_t i=sz;i<component_size;++i)
+    {
+        out.push_back(0);
+    }
+    out+=value;
+}
+
+void put_g1_point(Byte_buffer& out, G1_point const& pt)
+{
+    put_slot(out,pt.first);
+    put_slot(out,pt.second);
+}
+
+void put_g2_point(Byte_buffer& out, G2_point const& pt)
+{
+    put_slot(out,pt.first.first);
+    put_slot(out,pt.first.second);
+    put_slot(out,pt.second.first);
+    put_slot(out,pt.second.second);
+}
+
+void put_credential(Byte_buffer& out, Daa_credential const& cre)
+{
+    for (auto const& pt : cre)
+    {
+        put_g1_point(out,pt);
+    }
+}
+
+void put_field(Byte_buffer& out, Byte_buffer const& value)
+{
+    put_uint32(out,value.size());
+    out+=value;
+}
+
+// The header, with the length filled in by end_record
+Byte_buffer start_record(Daa_wire_type type, bool use_basename, size_t body_size)
+{
+    Byte_buffer out;
+    out.reserve(daa_wire_header_size+body_size);
+    out+=Byte_buffer(wire_magic,sizeof(wire_magic));
+    out.push_back(daa_wire_version);
+    out.push_back(static_cast<Byte>(type));
+    out.push_back(use_basename?daa_wire_basename:0);
+    out.push_back(0);
+    put_uint32(out,0);
+    return out;
+}
+
+void end_record(Byte_buffer& out)
+{
+    out.set_part(8,uint32_to_bb(static_cast<uint32_t>(out.size()-daa_wire_header_size)));
+}
+
+Byte_view slot_value(Byte_const_ptr slot)
+{
+    size_t sz=slot[0];
+    if (sz>component_size)
+    {
+        throw(std::runtime_error("daa_wire: bad slot length"));
+    }
+    return Byte_view(slot+daa_wire_slot_size-sz,sz);
+}
+
+// Walks through a record, checking that each part is inside it
+class Wire_reader
+{
+public:
+    Wire_reader(Byte_const_ptr data, size_t size) : data_(data), size_(size), pos_(0) {}
+    Byte_view take(size_t n)
+    {
+        if (n>size_-pos_)
+        {
+            throw(std::runtime_error("parse_daa_wire_record: the record is truncated"));
+        }
+        Byte_view f{data_+pos_,n};
+        pos_+=n;
+        return f;
+    }
+    Byte_view take_slots(size_t n)
+    {
+        Byte_view f=take(n*daa_wire_slot_size);
+        for (size_t i=0;i<n;++i)
+        {
+            if (f.data()[i*daa_wire_slot_size]>component_size)
+            {
+                throw(std::runtime_error("parse_daa_wire_record: bad slot length"));
+            }
+        }
+        return f;
+    }
+    Byte_view take_field()
+    {
+        return take(get_uint32(take(4).data()));
+    }
+    bool at_end() const {return pos_==size_;}
+
+private:
+    Byte_const_ptr data_;
+    size_t size_;
+    size_t pos_;
+};
+
+Byte_buffer read_field(std::istream& is, std::string const& name)
+{
+    Byte_buffer bb;
+    is >> bb;
+    if (bb.size()==0)
+    {
+        throw(std::runtime_error("Incomplete record: no "+name));
+    }
+    return bb;
+}
+
+std::string type_name(Daa_wire_type type)
+{
+    switch (type)
+    {
+    case Daa_wire_type::sign:
+        return "sign";
+    case Daa_wire_type::certify:
+        return "certify";
+    case Daa_wire_type::quote:
+        return "quote";
+    default:
+        break;
+    }
+    throw(std::runtime_error("daa_wire: not a signature or attestation"));
+}
+}
+
+Daa_wire_record parse_daa_wire_record(Byte_const_ptr data, size_t size)
+{
+    if (size<daa_wire_header_size || memcmp(data,wire_magic,sizeof(wire_magic))!=0)
+    {
+        throw(std::runtime_error("parse_daa_wire_record: not a DAA wire record"));
+    }
+    if (data[4]!=daa_wire_version)
+    {
+        throw(std::runtime_error("parse_daa_wire_record: unsupported version: "+std::to_string(data[4])));
+    }
+    if (data[5]<static_cast<Byte>(Daa_wire_type::issuer_public_keys) || data[5]>static_cast<Byte>(Daa_wire_type::quote))
+    {
+        throw(std::runtime_error("parse_daa_wire_record: unknown record type: "+std::to_string(data[5])));
+    }
+    if ((data[6]&~daa_wire_basename)!=0 || data[7]!=0)
+    {
+        throw(std::runtime_error("parse_daa_wire_record: unknown flags"));
+    }
+    if (get_uint32(data+8)!=size-daa_wire_header_size)
+    {
+        throw(std::runtime_error("parse_daa_wire_record: inconsistent length"));
+    }
+
+    Daa_wire_record rec{};
+    rec.type=static_cast<Daa_wire_type>(data[5]);
+    rec.use_basename=(data[6]&daa_wire_basename)!=0;
+    Wire_reader rd(data+daa_wire_header_size,size-daa_wire_header_size);
+    switch (rec.type)
+    {
+    case Daa_wire_type::issuer_public_keys:
+        rec.issuer_keys=rd.take_slots(8);
+        break;
+    case Daa_wire_type::credential:
+        rec.credential=rd.take_slots(8);
+        break;
+    default:
+        rec.issuer_keys=rd.take_slots(8);
+        if (rec.use_basename)
+        {
+            rec.pt_j=rd.take_slots(2);
+            rec.pt_k=rd.take_slots(2);
+        }
+        rec.credential=rd.take_slots(8);
+        for (auto& s : rec.sig)
+        {
+            s=slot_value(rd.take_slots(1).data());
+        }
+        rec.msg=rd.take_field();
+        if (rec.type!=Daa_wire_type::sign)
+        {
+            rec.key_pd=rd.take_field();
+            rec.cert=rd.take_field();
+        }
+        if (rec.use_basename)
+        {
+            rec.bsn=rd.take_field();
+        }
+        break;
+    }
+    if (rec.use_basename && rec.bsn.size()==0)
+    {
+        throw(std::runtime_error("parse_daa_wire_record: a basename flag without a basename"));
+    }
+    if (!rd.at_end())
+    {
+        throw(std::runtime_error("parse_daa_wire_record: extra data at the end of the record"));
+    }
+    return rec;
+}
+
+Daa_wire_record parse_daa_wire_record(Byte_buffer const& bb)
+{
+    return parse_daa_wire_record(bb.cdata(),bb.size());
+}
+
+G1_point wire_g1_point(Byte_view block)
+{
+    if (block.size()!=daa_wire_g1_point_size)
+    {
+        throw(std::runtime_error("wire_g1_point: incorrect block size"));
+    }
+    return std::make_pair(Byte_buffer(slot_value(block.data())),
+                          Byte_buffer(slot_value(block.data()+daa_wire_slot_size)));
+}
+
+Issuer_public_keys wire_issuer_public_keys(Byte_view block)
+{
+    if (block.size()!=daa_wire_issuer_keys_size)
+    {
+        throw(std::runtime_error("wire_issuer_public_keys: incorrect block size"));
+    }
+    Byte_buffer v[8];
+    for (size_t i=0;i<8;++i)
+    {
+        v[i]=Byte_buffer(slot_value(block.data()+i*daa_wire_slot_size));
+    }
+    return std::make_pair(std::make_pair(std::make_pair(v[0],v[1]),std::make_pair(v[2],v[3])),
+                          std::make_pair(std::make_pair(v[4],v[5]),std::make_pair(v[6],v[7])));
+}
+
+Daa_credential wire_daa_credential(Byte_view block)
+{
+    if (block.size()!=daa_wire_credential_size)
+    {
+        throw(std::runtime_error("wire_daa_credential: incorrect block size"));
+    }
+    Daa_credential cre;
+    for (size_t i=0;i<cre.size();++i)
+    {
+        cre[i]=wire_g1_point(Byte_view(block.data()+i*daa_wire_g1_point_size,daa_wire_g1_point_size));
+    }
+    return cre;
+}
+
+Daa_signature_record wire_to_signature_record(Daa_wire_record const& rec)
+{
+    if (rec.type!=Daa_wire_type::sign)
+    {
+        throw(std::runtime_error("wire_to_signature_record: not a signature record"));
+    }
+    Daa_signature_record sr;
+    sr.msg_digest=sha256_bb(Byte_buffer(rec.msg));
+    if (rec.use_basename)
+    {
+        sr.bsn=Byte_buffer(rec.bsn);
+        sr.pt_j=wire_g1_point(rec.pt_j);
+        sr.pt_k=wire_g1_point(rec.pt_k);
+    }
+    sr.r_cre=wire_daa_credential(rec.credential);
+    for (size_t i=0;i<sr.sig.size();++i)
+    {
+        sr.sig[i]=Byte_buffer(rec.sig[i]);
+    }
+    return sr;
+}
+
+Daa_attestation_record wire_to_attestation_record(Daa_wire_record const& rec)
+{
+    if (rec.type!=Daa_wire_type::certify && rec.type!=Daa_wire_type::quote)
+    {
+        throw(std::runtime_error("wire_to_attestation_record: not an attestation record"));
+    }
+    Daa_attestation_record ar;
+    ar.type=type_name(rec.type);
+    ar.label=Byte_buffer(rec.msg);
+    ar.key_pd=Byte_buffer(rec.key_pd);
+    ar.cert=Byte_buffer(rec.cert);
+    if (rec.use_basename)
+    {
+        ar.bsn=Byte_buffer(rec.bsn);
+        ar.pt_j=wire_g1_point(rec.pt_j);
+        ar.pt_k=wire_g1_point(rec.pt_k);
+    }
+    ar.r_cre=wire_daa_credential(rec.credential);
+    ar.nc=Byte_buffer(rec.sig[0]);
+    ar.sig_s=Byte_buffer(rec.sig[1]);
+    ar.h2=Byte_buffer(rec.sig[2]);
+    return ar;
+}
+
+Byte_buffer wire_encode_issuer_public_keys(Issuer_public_keys const& ipk)
+{
+    Byte_buffer out=start_record(Daa_wire_type::issuer_public_keys,false,daa_wire_issuer_keys_size);
+    put_g2_point(out,ipk.first);
+    put_g2_point(out,ipk.second);
+    end_record(out);
+    return out;
+}
+
+Byte_buffer wire_encode_daa_credential(Daa_credential const& cre)
+{
+    Byte_buffer out=start_record(Daa_wire_type::credential,false,daa_wire_credential_size);
+    put_credential(out,cre);
+    end_record(out);
+    return out;
+}
+
+Byte_buffer daa_text_record_to_wire(std::istream& is, bool use_basename)
+{
+    std::string type;
+    getline(is,type);
+    Daa_wire_type wt;
+    std::string msg;
+    Byte_buffer label;
+    Byte_buffer key_pd;
+    Byte_buffer cert;
+    if (type=="sign")
+    {
+        wt=Daa_wire_type::sign;
+        getline(is,msg);
+    }
+    else if (type=="certify" || type=="quote")
+    {
+        wt=(type=="certify")?Daa_wire_type::certify:Daa_wire_type::quote;
+        label=read_field(is,"label");
+        key_pd=read_field(is,"key public data");
+        cert=read_field(is,"attestation data");
+    }
+    else
+    {
+        throw(std::runtime_error("Not a signature or attestation record: "+type));
+    }
+    Issuer_public_keys ipk=deserialise_issuer_public_keys(read_field(is,"issuer public keys"));
+    Byte_buffer bsn;
+    G1_point pt_j;
+    G1_point pt_k;
+    if (use_basename)
+    {
+        bsn=read_field(is,"basename");
+        pt_j=g1_point_deserialise(read_field(is,"J"));
+        pt_k=g1_point_deserialise(read_field(is,"K"));
+    }
+    Daa_credential cre=deserialise_daa_credential(read_field(is,"credential"));
+    Byte_buffer n=read_field(is,"n");
+    Byte_buffer s=read_field(is,"s");
+    Byte_buffer h2=read_field(is,"h_2");
+
+    size_t fixed_size=daa_wire_issuer_keys_size+daa_wire_credential_size+3*daa_wire_slot_size+
+                      (use_basename?2*daa_wire_g1_point_size:0);
+    size_t variable_size=msg.size()+label.size()+key_pd.size()+cert.size()+bsn.size()+16;
+    Byte_buffer out=start_record(wt,use_basename,fixed_size+variable_size);
+    put_g2_point(out,ipk.first);
+    put_g2_point(out,ipk.second);
+    if (use_basename)
+    {
+        put_g1_point(out,pt_j);
+        put_g1_point(out,pt_k);
+    }
+    put_credential(out,cre);
+    put_slot(out,n);
+    put_slot(out,s);
+    put_slot(out,h2);
+    if (wt==Daa_wire_type::sign)
+    {
+        put_field(out,Byte_buffer(msg));
+    }
+    else
+    {
+        put_field(out,label);
+        put_field(out,key_pd);
+        put_field(out,cert);
+    }
+    if (use_basename)
+    {
+        put_field(out,bsn);
+    }
+    end_record(out);
+    return out;
+}
+
+void daa_wire_record_to_text(std::ostream& os, Daa_wire_record const& rec)
+{
+    if (rec.type==Daa_wire_type::issuer_public_keys)
+    {
+        os << serialise_issuer_public_keys(wire_issuer_public_keys(rec.issuer_keys)) << '\n';
+        return;
+    }
+    if (rec.type==Daa_wire_type::credential)
+    {
+        os << serialise_daa_credential(wire_daa_credential(rec.credential)) << '\n';
+        return;
+    }
+
+    os << type_name(rec.type) << '\n';
+    if (rec.type==Daa_wire_type::sign)
+    {
+        std::string msg(reinterpret_cast<char const*>(rec.msg.data()),rec.msg.size());
+        if (msg.find('\n')!=std::string::npos)
+        {
+            throw(std::runtime_error("daa_wire_record_to_text: the message has more than one line"));
+        }
+        os << msg << '\n';
+    }
+    else
+    {
+        os << Byte_buffer(rec.msg) << '\n';
+        os << Byte_buffer(rec.key_pd) << '\n';
+        os << Byte_buffer(rec.cert) << '\n';
+    }
+    os << serialise_issuer_public_keys(wire_issuer_public_keys(rec.issuer_keys)) << '\n';
+    if (rec.use_basename)
+    {
+        os << Byte_buffer(rec.bsn) << '\n';
+        os << g1_point_serialise(wire_g1_point(rec.pt_j)) << '\n';
+        os << g1_point_serialise(wire_g1_point(rec.pt_k)) << '\n';
+    }
+    os << serialise_daa_credential(wire_daa_credential(rec.credential)) << '\n';
+    for (auto const& s : rec.sig)
+    {
+        os << Byte_buffer(s) << '\n';
+    }
+}
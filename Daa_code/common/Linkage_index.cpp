@@ -0,0 +1,332 @@
+/*******************************************************************************
+* File:        Linkage_index.cpp
+* Description: An index of the pseudonyms (K) seen with each basename
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Byte_buffer.h"
+#include "Sha.h"
+#include "G1_utils.h"
+#include "Linkage_index.h"
+
+namespace
+{
+const char linkage_magic[8]={'D','A','A','L','I','N','K','1'};
+const uint32_t linkage_version=1;
+const uint32_t max_segment_bits=8;
+const uint64_t min_segment_capacity=64;
+// The entries start on a page boundary
+const size_t linkage_header_size=4096;
+
+std::runtime_error linkage_error(std::string const& msg)
+{
+	return std::runtime_error("Linkage_index: "+msg+": "+std::strerror(errno));
+}
+
+uint64_t round_up_capacity(uint64_t capacity)
+{
+	uint64_t c=min_segment_capacity;
+	while (c<capacity)
+	{
+		c<<=1;
+	}
+	return c;
+}
+}
+
+struct Linkage_index::Header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t segment_bits;
+	uint64_t capacity;
+	uint64_t segment_sizes[1<<max_segment_bits];
+};
+
+struct Linkage_index::Entry
+{
+	uint64_t hi;
+	uint32_t lo;
+	uint32_t count;     // 0 for an empty entry
+};
+
+Linkage_fingerprint linkage_fingerprint(Byte_buffer const& bsn, G1_point const& pt_k)
+{
+	Byte_buffer digest=sha256_bb(uint32_to_bb(static_cast<uint32_t>(bsn.size()))+bsn+g1_point_concat(pt_k));
+	Linkage_fingerprint fp{0,0};
+	for (size_t i=0;i<8;++i)
+	{
+		fp.hi=(fp.hi<<8)|digest[i];
+	}
+	for (size_t i=8;i<12;++i)
+	{
+		fp.lo=(fp.lo<<8)|digest[i];
+	}
+	return fp;
+}
+
+Linkage_index::Linkage_index(uint64_t capacity) : fd_(-1), map_(MAP_FAILED), map_size_(0)
+{
+	map_index(-1,capacity,true);
+}
+
+Linkage_index::Linkage_index(std::string const& filename, uint64_t capacity) : fd_(-1), map_(MAP_FAILED), map_size_(0)
+{
+	int fd=open(filename.c_str(),O_RDWR|O_CREAT,0644);
+	if (fd<0)
+	{
+		throw(linkage_error("unable to open "+filename));
+	}
+	try
+	{
+		// Held until the index is closed, waiting for any other process
+		if (flock(fd,LOCK_EX)!=0)
+		{
+			throw(linkage_error("unable to lock "+filename));
+		}
+		struct stat st;
+		if (fstat(fd,&st)!=0)
+		{
+			throw(linkage_error("unable to read the size of "+filename));
+		}
+		map_index(fd,capacity,st.st_size==0);
+	}
+	catch (...)
+	{
+		close(fd);
+		throw;
+	}
+	fd_=fd;
+}
+
+Linkage_index::~Linkage_index()
+{
+	if (map_!=MAP_FAILED)
+	{
+		munmap(map_,map_size_);
+	}
+	if (fd_>=0)
+	{
+		close(fd_);
+	}
+}
+
+void Linkage_index::map_index(int fd, uint64_t capacity, bool is_new)
+{
+	static_assert(sizeof(Header)<=linkage_header_size,"Linkage_index: the header is too big");
+	static_assert(sizeof(Entry)==16,"Linkage_index: entries must be 16 bytes");
+
+	if (is_new)
+	{
+		capacity=round_up_capacity(capacity);
+		map_size_=linkage_header_size+capacity*sizeof(Entry);
+		if (fd>=0 && ftruncate(fd,map_size_)!=0)
+		{
+			throw(linkage_error("unable to size the index file"));
+		}
+	}
+	else
+	{
+		struct stat st;
+		fstat(fd,&st);
+		map_size_=st.st_size;
+		if (map_size_<linkage_header_size)
+		{
+			throw(std::runtime_error("Linkage_index: the file is too short to be an index"));
+		}
+	}
+
+	int flags=(fd<0)?MAP_PRIVATE|MAP_ANONYMOUS:MAP_SHARED;
+	map_=mmap(nullptr,map_size_,PROT_READ|PROT_WRITE,flags,fd,0);
+	if (map_==MAP_FAILED)
+	{
+		throw(linkage_error("unable to map the index"));
+	}
+	header_=static_cast<Header*>(map_);
+	entries_=reinterpret_cast<Entry*>(static_cast<char*>(map_)+linkage_header_size);
+
+	if (is_new)
+	{
+		// A new file and anonymous memory are zero filled, so every entry is empty
+		uint32_t segment_bits=0;
+		while (segment_bits<max_segment_bits && (capacity>>(segment_bits+1))>=min_segment_capacity)
+		{
+			++segment_bits;
+		}
+		std::memcpy(header_->magic,linkage_magic,sizeof(linkage_magic));
+		header_->version=linkage_version;
+		header_->segment_bits=segment_bits;
+		header_->capacity=capacity;
+	}
+	else
+	{
+		try
+		{
+			check_header();
+		}
+		catch (...)
+		{
+			munmap(map_,map_size_);
+			map_=MAP_FAILED;
+			throw;
+		}
+	}
+
+	segment_capacity_=header_->capacity>>header_->segment_bits;
+	segment_mutexes_.reset(new std::mutex[1<<header_->segment_bits]);
+}
+
+void Linkage_index::check_header() const
+{
+	if (std::memcmp(header_->magic,linkage_magic,sizeof(linkage_magic))!=0 || header_->version!=linkage_version)
+	{
+		throw(std::runtime_error("Linkage_index: the file is not a linkage index"));
+	}
+	uint64_t capacity=header_->capacity;
+	if (header_->segment_bits>max_segment_bits || capacity<min_segment_capacity || (capacity&(capacity-1))!=0
+		|| (capacity>>header_->segment_bits)<min_segment_capacity
+		|| map_size_!=linkage_header_size+capacity*sizeof(Entry))
+	{
+		throw(std::runtime_error("Linkage_index: the index file is corrupt"));
+	}
+	// Inserting keeps each segment at most 7/8 full, so the probes end
+	uint64_t segment_capacity=capacity>>header_->segment_bits;
+	for (uint32_t seg=0;seg<(1U<<header_->segment_bits);++seg)
+	{
+		if (header_->segment_sizes[seg]*8>segment_capacity*7)
+		{
+			throw(std::runtime_error("Linkage_index: the index file is corrupt"));
+		}
+	}
+}
+
+uint32_t Linkage_index::segment_of(Linkage_fingerprint const& fp) const
+{
+	if (header_->segment_bits==0)
+		return 0;
+
+	return static_cast<uint32_t>(fp.hi>>(64-header_->segment_bits));
+}
+
+Linkage_index::Entry* Linkage_index::find_entry(Linkage_fingerprint const& fp) const
+{
+	// Linear probing from the low bits of the fingerprint. A segment is never
+	// more than 7/8 full, but the sizes in a damaged file may be wrong, so the
+	// search stops after one pass round the segment.
+	Entry* segment=entries_+segment_of(fp)*segment_capacity_;
+	uint64_t mask=segment_capacity_-1;
+	uint64_t i=fp.hi&mask;
+	for (uint64_t probes=0;probes<segment_capacity_;++probes)
+	{
+		if (segment[i].count==0 || (segment[i].hi==fp.hi && segment[i].lo==fp.lo))
+		{
+			return segment+i;
+		}
+		i=(i+1)&mask;
+	}
+	throw(std::runtime_error("Linkage_index: the index file is corrupt"));
+}
+
+uint32_t Linkage_index::insert_or_get_count(Linkage_fingerprint const& fp)
+{
+	uint32_t seg=segment_of(fp);
+	std::lock_guard<std::mutex> lock(segment_mutexes_[seg]);
+	Entry* e=find_entry(fp);
+	if (e->count==0)
+	{
+		if ((header_->segment_sizes[seg]+1)*8>segment_capacity_*7)
+		{
+			throw(std::runtime_error("Linkage_index: the index is full"));
+		}
+		e->hi=fp.hi;
+		e->lo=fp.lo;
+		++header_->segment_sizes[seg];
+	}
+	if (e->count!=UINT32_MAX)
+	{
+		++e->count;
+	}
+	return e->count;
+}
+
+uint32_t Linkage_index::insert_or_get_count(Byte_buffer const& bsn, G1_point const& pt_k)
+{
+	return insert_or_get_count(linkage_fingerprint(bsn,pt_k));
+}
+
+uint32_t Linkage_index::count(Linkage_fingerprint const& fp) const
+{
+	std::lock_guard<std::mutex> lock(segment_mutexes_[segment_of(fp)]);
+	return find_entry(fp)->count;
+}
+
+uint32_t Linkage_index::count(Byte_buffer const& bsn, G1_point const& pt_k) const
+{
+	return count(linkage_fingerprint(bsn,pt_k));
+}
+
+uint64_t Linkage_index::size() const
+{
+	uint64_t total=0;
+	for (uint32_t seg=0;seg<(1U<<header_->segment_bits);++seg)
+	{
+		std::lock_guard<std::mutex> lock(segment_mutexes_[seg]);
+		total+=header_->segment_sizes[seg];
+	}
+	return total;
+}
+
+uint64_t Linkage_index::capacity() const
+{
+	return header_->capacity;
+}
+
+void Linkage_index::flush()
+{
+	if (fd_>=0 && msync(map_,map_size_,MS_SYNC)!=0)
+	{
+		throw(linkage_error("unable to write the index file"));
+	}
+}
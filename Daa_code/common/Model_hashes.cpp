@@ -42,34 +42,116 @@
 #include <iostream>
 #include <string>
 #include <array>
+#include <vector>
+#include <stdexcept>
 #include "Byte_buffer.h"
 #include "Sha.h"
+#include "Sha256_multi.h"
 #include "G1_utils.h"
 #include "G2_utils.h"
 #include "Openssl_bn_utils.h"
 #include "Daa_credential.h"
 #include "bnp256_param.h"
+#include "Scalar_bnp256.h"
+#include "Model_hashes.h"
+
+Transcript& Transcript::add(G1_point const& pt)
+{
+    hasher_.update_padded(pt.first,g1_coord_size);
+    hasher_.update_padded(pt.second,g1_coord_size);
+    return *this;
+}
+
+Transcript& Transcript::add(Daa_credential const& cre)
+{
+    for (auto const& pt : cre)
+    {
+        add(pt);
+    }
+    return *this;
+}
+
+Scalar_bnp256 Transcript::to_scalar()
+{
+    Byte digest[sha256_digest_size];
+    hasher_.finish(digest);
+    return Scalar_bnp256(digest,sha256_digest_size);
+}
+
+Transcript_batch& Transcript_batch::add(Byte_view bv)
+{
+    data_.append(bv);
+    ends_.back()=data_.size();
+    return *this;
+}
+
+Transcript_batch& Transcript_batch::add(G1_point const& pt)
+{
+    if (pt.first.size()>g1_coord_size || pt.second.size()>g1_coord_size)
+    {
+        throw(std::runtime_error("Transcript_batch::add: coordinate too long"));
+    }
+    data_.resize(data_.size()+g1_coord_size-pt.first.size());
+    data_+=pt.first;
+    data_.resize(data_.size()+g1_coord_size-pt.second.size());
+    data_+=pt.second;
+    ends_.back()=data_.size();
+    return *this;
+}
+
+Transcript_batch& Transcript_batch::add(Daa_credential const& cre)
+{
+    for (auto const& pt : cre)
+    {
+        add(pt);
+    }
+    return *this;
+}
+
+void Transcript_batch::discard_last()
+{
+    ends_.pop_back();
+    data_.resize((ends_.size()!=0)?ends_.back():0);
+}
+
+std::vector<Byte_buffer> Transcript_batch::digests() const
+{
+    std::vector<Byte_buffer> hashes(ends_.size(),Byte_buffer(sha256_digest_size,0));
+    std::vector<Byte_view> msgs(ends_.size());
+    std::vector<Byte_ptr> outputs(ends_.size());
+    size_t start=0;
+    for (size_t i=0;i<ends_.size();++i)
+    {
+        msgs[i]=data_.view(start,ends_[i]-start);
+        outputs[i]=hashes[i].data();
+        start=ends_[i];
+    }
+    sha256_multi(msgs.data(),outputs.data(),msgs.size());
+    return hashes;
+}
 
 Byte_buffer host_str(G2_point const& x, G2_point const& y, Byte_buffer const& key, Byte_buffer const& ek)
 {
-    return g2_point_concat(x)+g2_point_concat(y)+key+ek;
+    Byte_buffer bb;
+    bb.reserve(2*g2_affine_point_size+key.size()+ek.size());
+    bb+=g2_point_concat(x);
+    bb+=g2_point_concat(y);
+    bb+=key;
+    bb+=ek;
+    return bb;
 }
 
 Byte_buffer host_p(G1_point const& p1, G1_point const& daa_key, G1_point const& e, Byte_buffer const& str)
 {
-    Byte_buffer bb=g1_point_concat(p1)+g1_point_concat(daa_key)+g1_point_concat(e)+str;
-    return sha256_bb(bb);
+    return Transcript().add(p1).add(daa_key).add(e).add(str).digest();
 }
 
 Byte_buffer issuer_u(G1_point p1, G1_point const& daa_key, Daa_credential const& cre, G1_point const& rb, G1_point const& rd)
 {
-    Byte_buffer tmp_bb=g1_point_concat(p1)+g1_point_concat(daa_key)+daa_credential_concat(cre)+g1_point_concat(rb)+g1_point_concat(rd);
-    return bb_mod(sha256_bb(tmp_bb),bnp256_order);
+    return Transcript().add(p1).add(daa_key).add(cre).add(rb).add(rd).to_scalar().to_byte_buffer();
 }
 
 Byte_buffer sign_c(Byte_buffer const& label, Daa_credential const& cre, G1_point const& j, G1_point const& k, G1_point const& l, G1_point const& e)
 {
-    Byte_buffer tmp_bb=label+daa_credential_concat(cre)+g1_point_concat(j)+g1_point_concat(k)+g1_point_concat(l)+g1_point_concat(e);
-    return sha256_bb(tmp_bb);
+    return Transcript().add(label).add(cre).add(j).add(k).add(l).add(e).digest();
 }
-
@@ -57,7 +57,10 @@
 #include "bnp256_param.h"
 #include "Openssl_bnp256.h"
 #include "Sha.h"
+#include "Model_hashes.h"
 #include "Credential_issuer.h"
+#include "Scalar_bnp256.h"
+#include "Curve_backend.h"
 
 bool openssl_daa_verify(
 bool new_daa_signature,
@@ -66,36 +69,21 @@ Byte_buffer const& str,
 Daa_signature const& sig
 )
 {
-    Bn_ctx_ptr ctx =new_bn_ctx();
-    Ec_group_ptr ecgrp=new_ec_group("bnp256");
-    if (ecgrp.get()==nullptr)
-    {
-        throw(Openssl_error("openssl_daa_verify: error generating the curve"));
-    }
-    if (1!=EC_GROUP_check(ecgrp.get(),ctx.get()))
-    {
-        throw(Openssl_error("openssl_daa_verify: EC_GROUP_check failed"));
-    }
-
     // v
     Byte_buffer const& v=sig[0];
     //w
     Byte_buffer const& w=sig[1];
-    // [w]P_1
-    G1_point w_p1_bb=ec_generator_mul(ecgrp,w);
-    // [v]Q_2
-    G1_point v_q2_bb=ec_point_mul(ecgrp,v,daa_public_key);
-    // U'
-    G1_point tmp_bb=ec_point_invert(ecgrp,v_q2_bb);
-    G1_point u_prime_bb=ec_point_add(ecgrp,w_p1_bb,tmp_bb); 
+    // U'=[w]P_1-[v]Q_2
+    Curve::G1 u_prime=Curve::multi_mul({w,v},{Curve::G1::generator(),-Curve::G1(daa_public_key)});
+    G1_point u_prime_bb=u_prime.to_g1_point();
     
     G1_point p1=std::make_pair(bnp256_gX,bnp256_gY);
-	Byte_buffer pp=sha256_bb(g1_point_concat(p1)+g1_point_concat(daa_public_key)+g1_point_concat(u_prime_bb)+str);
+	Byte_buffer pp=host_p(p1,daa_public_key,u_prime_bb,str);
 	Byte_buffer pp_tpm=sha256_bb(pp);
 
     Byte_buffer const& k=sig[2];
-	Byte_buffer v_prime=(!new_daa_signature)?bb_mod(pp_tpm,bnp256_order)
-											:bb_mod(sha256_bb(k+pp_tpm),bnp256_order);
+	Byte_buffer v_prime=(!new_daa_signature)?Scalar_bnp256(pp_tpm).to_byte_buffer()
+											:hash_to_scalar(k+pp_tpm).to_byte_buffer();
 
     bool verified_OK=(v==v_prime);
  
@@ -0,0 +1,305 @@
+/*******************************************************************************
+* File:        Revocation_check.cpp
+* Description: Checks basename signatures against a list of revoked DAA secret keys
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Clock_utils.h"
+#include "G1_ecp.h"
+#include "G1_fixed_base.h"
+#include "Revocation_check.h"
+
+namespace
+{
+// Below this G1_prepared_point is cheaper than building a G1_fixed_base
+const size_t fixed_base_min_keys=16;
+// Fewer keys than this for each thread are done on fewer threads
+const size_t min_keys_per_thread=32;
+// The number of basenames, checked fewer than threshold times, remembered
+const size_t max_seen_for_each_table=64;
+
+// 63 bits of x and the parity of y, as [f]J and [n-f]J=-[f]J have the same x
+uint64_t point_hash(G1_point const& pt)
+{
+	Byte_buffer x=pt.first;
+	x.pad_left(g1_coord_size);
+	uint64_t h=0;
+	for (size_t i=x.size()-8;i<x.size();++i)
+	{
+		h=(h<<8)|x[i];
+	}
+	Byte_buffer const& y=pt.second;
+	uint64_t y_odd=(y.size()!=0)?(y[y.size()-1]&1):0;
+	return (h&0x7fffffffffffffffULL)|(y_odd<<63);
+}
+
+// Runs work(first,last) for n_threads contiguous parts of [0,n), the first
+// part on the calling thread
+template<typename Work>
+void run_in_parts(size_t n, size_t n_threads, Work work)
+{
+	std::vector<std::thread> threads;
+	for (size_t t=1;t<n_threads;++t)
+	{
+		threads.emplace_back(work,t*n/n_threads,(t+1)*n/n_threads);
+	}
+	work(0,n/n_threads);
+	for (auto& th : threads)
+	{
+		th.join();
+	}
+}
+
+template<typename Table>
+std::vector<uint64_t> revoked_point_hashes(Table const& j_table, std::vector<Byte_buffer> const& keys, size_t n_threads)
+{
+	std::vector<uint64_t> hashes(keys.size());
+	run_in_parts(keys.size(),n_threads,[&](size_t first, size_t last){
+		std::vector<G1_ecp> pts;
+		pts.reserve(last-first);
+		for (size_t i=first;i<last;++i)
+		{
+			pts.push_back(j_table.mul(keys[i]));
+		}
+		auto g1_pts=g1_batch_to_g1_points(std::move(pts));
+		for (size_t i=first;i<last;++i)
+		{
+			hashes[i]=point_hash(g1_pts[i-first]);
+		}
+	});
+	return hashes;
+}
+
+template<typename Table>
+uint64_t scan_revoked_keys(Table const& j_table, G1_ecp const& k, std::vector<Byte_buffer> const& keys, size_t n_threads, bool& revoked)
+{
+	std::atomic<bool> found(false);
+	std::atomic<uint64_t> points(0);
+	run_in_parts(keys.size(),n_threads,[&](size_t first, size_t last){
+		uint64_t calculated=0;
+		for (size_t i=first;i<last && !found.load(std::memory_order_relaxed);++i)
+		{
+			++calculated;
+			if (j_table.mul(keys[i])==k)
+			{
+				found=true;
+			}
+		}
+		points+=calculated;
+	});
+	revoked=found;
+	return points;
+}
+}
+
+Revocation_checker::Revocation_checker(
+std::vector<Byte_buffer> const& revoked_keys,
+size_t number_of_threads,
+size_t table_capacity,
+uint32_t table_threshold
+) : revoked_keys_(revoked_keys),
+	number_of_threads_((number_of_threads!=0)?number_of_threads:std::max(1U,std::thread::hardware_concurrency())),
+	table_capacity_(table_capacity),
+	table_threshold_(std::max(1U,table_threshold)),
+	stats_{0,0,0,0,0.0}
+{
+	if (revoked_keys_.size()>UINT32_MAX)
+	{
+		throw(std::runtime_error("Revocation_checker: too many revoked keys"));
+	}
+}
+
+bool Revocation_checker::is_revoked(Byte_buffer const& bsn, G1_point const& pt_j, G1_point const& pt_k)
+{
+	if (bsn.size()==0)
+	{
+		throw(std::runtime_error("Revocation_checker: the basename is empty"));
+	}
+
+	F_timer_mu timer;
+	bool revoked=false;
+	bool from_table=false;
+	uint64_t points=0;
+	if (!revoked_keys_.empty())
+	{
+		Table_ptr table=find_table(bsn);
+		if (!table && table_capacity_!=0 && note_seen(bsn)>=table_threshold_)
+		{
+			table=make_table(pt_j);
+			points+=revoked_keys_.size();
+			add_table(bsn,table);
+		}
+		if (table)
+		{
+			from_table=true;
+			// Only part of the point was compared, so each key with the same
+			// hash is checked
+			auto range=table->equal_range(point_hash(pt_k));
+			for (auto it=range.first;it!=range.second && !revoked;++it)
+			{
+				++points;
+				revoked=(revoked_keys_[it->second]*G1_ecp(pt_j)==G1_ecp(pt_k));
+			}
+		}
+		else
+		{
+			points+=scan(pt_j,pt_k,revoked);
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(checker_mutex_);
+	++stats_.checks;
+	if (from_table)
+	{
+		++stats_.table_checks;
+	}
+	if (revoked)
+	{
+		++stats_.revoked;
+	}
+	stats_.points+=points;
+	stats_.check_microseconds+=timer.get_duration();
+	return revoked;
+}
+
+Revocation_stats Revocation_checker::stats() const
+{
+	std::lock_guard<std::mutex> lock(checker_mutex_);
+	return stats_;
+}
+
+Revocation_checker::Table_ptr Revocation_checker::find_table(Byte_buffer const& bsn)
+{
+	std::lock_guard<std::mutex> lock(checker_mutex_);
+	auto it=index_.find(bsn);
+	if (it==index_.end())
+		return Table_ptr();
+
+	lru_.splice(lru_.begin(),lru_,it->second);
+	return it->second->second;
+}
+
+uint32_t Revocation_checker::note_seen(Byte_buffer const& bsn)
+{
+	std::lock_guard<std::mutex> lock(checker_mutex_);
+	if (seen_.size()>=max_seen_for_each_table*table_capacity_ && seen_.find(bsn)==seen_.end())
+	{
+		seen_.clear();
+	}
+	return ++seen_[bsn];
+}
+
+void Revocation_checker::add_table(Byte_buffer const& bsn, Table_ptr const& table)
+{
+	std::lock_guard<std::mutex> lock(checker_mutex_);
+	seen_.erase(bsn);
+	if (index_.find(bsn)!=index_.end())
+		return;
+
+	lru_.emplace_front(bsn,table);
+	index_[bsn]=lru_.begin();
+	if (lru_.size()>table_capacity_)
+	{
+		index_.erase(lru_.back().first);
+		lru_.pop_back();
+	}
+}
+
+Revocation_checker::Table_ptr Revocation_checker::make_table(G1_point const& pt_j) const
+{
+	size_t n=revoked_keys_.size();
+	G1_ecp j(pt_j);
+	std::vector<uint64_t> hashes;
+	if (n<fixed_base_min_keys)
+	{
+		hashes=revoked_point_hashes(G1_prepared_point(j),revoked_keys_,1);
+	}
+	else
+	{
+		hashes=revoked_point_hashes(G1_fixed_base(j),revoked_keys_,threads_for(n));
+	}
+	std::shared_ptr<Revocation_table> table=std::make_shared<Revocation_table>();
+	table->reserve(n);
+	for (uint32_t i=0;i<n;++i)
+	{
+		table->emplace(hashes[i],i);
+	}
+	return table;
+}
+
+uint64_t Revocation_checker::scan(G1_point const& pt_j, G1_point const& pt_k, bool& revoked) const
+{
+	size_t n=revoked_keys_.size();
+	G1_ecp j(pt_j);
+	G1_ecp k(pt_k);
+	if (n<fixed_base_min_keys)
+		return scan_revoked_keys(G1_prepared_point(j),k,revoked_keys_,1,revoked);
+
+	return scan_revoked_keys(G1_fixed_base(j),k,revoked_keys_,threads_for(n),revoked);
+}
+
+size_t Revocation_checker::threads_for(size_t n_keys) const
+{
+	return std::max<size_t>(1,std::min(number_of_threads_,n_keys/min_keys_per_thread));
+}
+
+std::vector<Byte_buffer> read_revocation_list(std::string const& filename)
+{
+	std::ifstream is(filename.c_str());
+	if (!is)
+	{
+		throw(std::runtime_error("Unable to open the revocation list: "+filename));
+	}
+	std::vector<Byte_buffer> keys;
+	Byte_buffer f;
+	while (is)
+	{
+		is >> f;
+		if (f.size()!=0)
+		{
+			keys.push_back(f);
+		}
+	}
+	return keys;
+}
@@ -61,6 +61,8 @@
 #include "Tpm_error.h"
 #include "Tpm_defs.h"
 #include "Daa_certify.h"
+#include "Scalar_bnp256.h"
+#include "Curve_backend.h"
 
 bool verify_daa_attestation(
 bool new_daa_signature,
@@ -81,48 +83,22 @@ Byte_buffer const& sig_s
     {
         Byte_buffer hash1=sha256_bb(c+attest_hash);
 
-        Bn_ctx_ptr ctx=new_bn_ctx();
-        Ec_group_ptr ecgrp=new_ec_group("bnp256");
-        if (ecgrp.get()==nullptr)
-        {
-            throw(Tpm_error("Error generating the ECC curve"));
-        }
-        if (1!=EC_GROUP_check(ecgrp.get(),ctx.get()))
-        {
-            throw(Tpm_error("ECC curve check failed"));
-        }
-
         // h_2
-        Byte_buffer hash2=(!new_daa_signature)?nt:bb_mod(sha256_bb(nt+hash1),bnp256_order);
+        Byte_buffer hash2=(!new_daa_signature)?nt:hash_to_scalar(nt+hash1).to_byte_buffer();
 
         G1_point l_prime_bb;
-        G1_point e_prime_bb;
-        G1_point tmp_bb;
         if (pt_j.first.size()>0)   // Basename set, so calculate L'
         {
-            // [s]J
-            G1_point s_j_bb=ec_point_mul(ecgrp,sig_s,pt_j);
-            // [h_2]K
-            G1_point h2_k_bb=ec_point_mul(ecgrp,hash2,pts[0]);
-            // L'
-            tmp_bb=ec_point_invert(ecgrp,h2_k_bb);
-            l_prime_bb=ec_point_add(ecgrp,s_j_bb,tmp_bb); 
-        }
-        // [s]S
-        G1_point s_pt_s_bb=ec_point_mul(ecgrp,sig_s,r_cre1[1]);
-        // [h_2]W
-        G1_point h2_pt_w_bb=ec_point_mul(ecgrp,hash2,r_cre1[3]);
-        // E'
-        tmp_bb=ec_point_invert(ecgrp,h2_pt_w_bb);
-        e_prime_bb=ec_point_add(ecgrp,s_pt_s_bb,tmp_bb); 
-
-        if (log_ptr->debug_level()>0)
-        {
-            log_ptr->os() << "verify_daa_attastation: calculated points: \nL'_x :" << l_prime_bb.first.to_hex_string()
-                          << "\nL'_y: " << l_prime_bb.second.to_hex_string() << "\nE'_x: "
-                          << e_prime_bb.first.to_hex_string() << "\nE'_y: " << e_prime_bb.second.to_hex_string()
-                          << std::endl;
+            // L'=[s]J-[h_2]K
+            Curve::G1 l_prime=Curve::multi_mul({sig_s,hash2},{Curve::G1(pt_j),-Curve::G1(pts[0])});
+            l_prime_bb=l_prime.to_g1_point();
         }
+        // E'=[s]S-[h_2]W
+        Curve::G1 e_prime=Curve::multi_mul({sig_s,hash2},{Curve::G1(r_cre1[1]),-Curve::G1(r_cre1[3])});
+        G1_point e_prime_bb=e_prime.to_g1_point();
+
+        LOG_DEBUG(1,"verify_daa_attastation: calculated points: \nL'_x :{}\nL'_y: {}\nE'_x: {}\nE'_y: {}",
+                  l_prime_bb.first,l_prime_bb.second,e_prime_bb.first,e_prime_bb.second);
 
 
         Byte_buffer v_c=sign_c(label,r_cre1,pt_j,pts[0],l_prime_bb,e_prime_bb);
@@ -130,7 +106,7 @@ Byte_buffer const& sig_s
         verified_OK=(v_c==c);
 
     }
-    catch (Tpm_error &e)
+    catch (std::runtime_error &e)
 	{
 	    std::cerr << e.what() << '\n';
 	}
@@ -0,0 +1,319 @@
+/*******************************************************************************
+* File:        Verify_daa_batch.cpp
+* Description: Batch verification of DAA signatures made with the same issuer keys
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdint>
+#include <string>
+#include <iostream>
+#include "Byte_buffer.h"
+#include "Openssl_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Openssl_ec_utils.h"
+#include "Openssl_ec_map_to_point.h"
+#include "Basename_cache.h"
+#include "bnp256_param.h"
+#include "Sha.h"
+#include "Model_hashes.h"
+#include "Scalar_bnp256.h"
+#include "G2_utils.h"
+#include "Amcl_utils.h"
+#include "G1_ecp.h"
+#include "Amcl_pairings.h"
+#include "Tpm_defs.h"
+#include "Verify_daa_batch.h"
+
+using namespace FP256BN;
+using namespace FP256BN_BIG;
+
+namespace
+{
+// Checks J, if a basename is used, and calculates L' and E'
+bool calculate_commit_points(Daa_signature_record const& rec, G1_point& l_prime_bb, G1_point& e_prime_bb)
+{
+    Byte_buffer const& sig_s=rec.sig[1];
+    Byte_buffer const& hash2=rec.sig[2];
+
+    if (rec.bsn.size()!=0)
+    {
+        G1_point pt_j_prime=basename_cache().get(rec.bsn).pt_j;
+        if (rec.pt_j!=pt_j_prime)
+        {
+            LOG_DEBUG(1,"verify_daa_signature_hash: J != J'");
+            return false;
+        }
+        // L'=[s]J-[h_2]K
+        G1_ecp l_prime=ec_multi_mul({sig_s,hash2},{G1_ecp(rec.pt_j),-G1_ecp(rec.pt_k)});
+        l_prime_bb=l_prime.to_g1_point();
+    }
+    // E'=[s]S-[h_2]W
+    G1_ecp e_prime=ec_multi_mul({sig_s,hash2},{G1_ecp(rec.r_cre[1]),-G1_ecp(rec.r_cre[3])});
+    e_prime_bb=e_prime.to_g1_point();
+    return true;
+}
+
+// The hash checks for a set of signatures. Each step, c, H(c) and then h_2,
+// is hashed for all of the signatures together.
+std::vector<bool> check_signature_hashes(Daa_signature_records const& recs)
+{
+    std::vector<bool> passed(recs.size(),false);
+    std::vector<size_t> pending;
+    pending.reserve(recs.size());
+    Transcript_batch c_batch;
+    for (size_t i=0;i<recs.size();++i)
+    {
+        Daa_signature_record const& rec=recs[i];
+        try
+        {
+            G1_point l_prime_bb,e_prime_bb;
+            if (calculate_commit_points(rec,l_prime_bb,e_prime_bb))
+            {
+                c_batch.next();
+                try
+                {
+                    c_batch.add(rec.msg_digest).add(rec.r_cre).add(rec.pt_j).add(rec.pt_k).add(l_prime_bb).add(e_prime_bb);
+                }
+                catch (...)
+                {
+                    c_batch.discard_last();
+                    throw;
+                }
+                pending.push_back(i);
+            }
+        }
+        catch (std::runtime_error const& e)
+        {
+            LOG_DEBUG(1,"verify_daa_signature_hash: {}",e.what());
+        }
+    }
+
+    std::vector<Byte_buffer> c=c_batch.digests();
+    Transcript_batch c_hash_batch;
+    for (auto const& v_c : c)
+    {
+        c_hash_batch.next().add(v_c);
+    }
+    std::vector<Byte_buffer> c_hash=c_hash_batch.digests();
+    Transcript_batch h2_batch;
+    for (size_t k=0;k<pending.size();++k)
+    {
+        h2_batch.next().add(recs[pending[k]].sig[0]).add(c_hash[k]);
+    }
+    std::vector<Byte_buffer> h2=h2_batch.digests();
+
+    for (size_t k=0;k<pending.size();++k)
+    {
+        Byte_buffer h2_prime=Scalar_bnp256(h2[k].cdata(),h2[k].size()).to_byte_buffer();
+        passed[pending[k]]=(h2_prime==recs[pending[k]].sig[2]);
+    }
+    return passed;
+}
+}
+
+bool verify_daa_signature_hash(Daa_signature_record const& rec)
+{
+    try
+    {
+        G1_point l_prime_bb,e_prime_bb;
+        if (!calculate_commit_points(rec,l_prime_bb,e_prime_bb))
+        {
+            return false;
+        }
+
+        Byte_buffer v_c=sign_c(rec.msg_digest,rec.r_cre,rec.pt_j,rec.pt_k,l_prime_bb,e_prime_bb);
+
+        Byte_buffer h2_prime=hash_to_scalar(rec.sig[0]+sha256_bb(v_c)).to_byte_buffer();
+
+        return (h2_prime==rec.sig[2]);
+    }
+    catch (std::runtime_error const& e)
+    {
+        LOG_DEBUG(1,"verify_daa_signature_hash: {}",e.what());
+    }
+
+    return false;
+}
+
+namespace
+{
+// The credential points needed for the pairing checks, A+D is pre-calculated
+struct Batch_entry
+{
+    ECP a;
+    ECP b;
+    ECP c;
+    ECP ad;
+};
+
+// For random d_i, e_i check that:
+//   e(Y,sum(d_i.A_i)).e(X,sum(e_i.(A_i+D_i))).e(P2,-sum(d_i.B_i+e_i.C_i))=1
+// which holds, with overwhelming probability, only if every credential in
+// the range satisfies both e(Y,A)=e(P2,B) and e(X,A+D)=e(P2,C)
+bool check_combined_pairings(
+std::vector<Batch_entry>& entries,
+std::vector<size_t> const& idx,
+size_t begin,
+size_t end,
+Prepared_issuer_keys const& ipk,
+Random_byte_generator& rbg
+)
+{
+    ECP sum_a,sum_ad,sum_bc;
+    ECP_inf(&sum_a);
+    ECP_inf(&sum_ad);
+    ECP_inf(&sum_bc);
+
+    ECP tmp_1,tmp_2;
+    BIG delta,eps;
+    for (size_t i=begin;i<end;++i)
+    {
+        Batch_entry& be=entries[idx[i]];
+        bb_to_big(rbg(batch_exponent_bytes),delta);
+        bb_to_big(rbg(batch_exponent_bytes),eps);
+
+        ECP_copy(&tmp_1,&be.a);
+        ECP_mul(&tmp_1,delta);
+        ECP_add(&sum_a,&tmp_1);
+
+        ECP_copy(&tmp_1,&be.ad);
+        ECP_mul(&tmp_1,eps);
+        ECP_add(&sum_ad,&tmp_1);
+
+        ECP_copy(&tmp_1,&be.b);
+        ECP_copy(&tmp_2,&be.c);
+        ECP_mul2(&tmp_1,&tmp_2,delta,eps);
+        ECP_add(&sum_bc,&tmp_1);
+    }
+
+    ECP_neg(&sum_bc);
+    return amcl_prepared_product_is_one({{&ipk.y(),&sum_a},{&ipk.x(),&sum_ad},{&ipk.p2(),&sum_bc}});
+}
+
+void bisect_pairing_checks(
+Daa_signature_records const& recs,
+Prepared_issuer_keys const& ipk,
+std::vector<Batch_entry>& entries,
+std::vector<size_t> const& idx,
+size_t begin,
+size_t end,
+Random_byte_generator& rbg,
+std::vector<bool>& results
+)
+{
+    if (end-begin==1)
+    {
+        results[idx[begin]]=check_daa_pairings(recs[idx[begin]].r_cre,ipk);
+        return;
+    }
+
+    if (check_combined_pairings(entries,idx,begin,end,ipk,rbg))
+    {
+        for (size_t i=begin;i<end;++i)
+        {
+            results[idx[i]]=true;
+        }
+        return;
+    }
+
+    LOG_DEBUG(1,"Combined pairing check failed for signatures {} to {}, bisecting",begin,end-1);
+
+    size_t mid=begin+(end-begin)/2;
+    bisect_pairing_checks(recs,ipk,entries,idx,begin,mid,rbg,results);
+    bisect_pairing_checks(recs,ipk,entries,idx,mid,end,rbg,results);
+}
+}
+
+std::vector<bool> verify_daa_signatures_batch(
+Daa_signature_records const& recs,
+Issuer_public_keys const& ipk,
+Random_byte_generator& rbg
+)
+{
+    return verify_daa_signatures_batch(recs,Prepared_issuer_keys(ipk),rbg);
+}
+
+std::vector<bool> verify_daa_signatures_batch(
+Daa_signature_records const& recs,
+Prepared_issuer_keys const& ipk,
+Random_byte_generator& rbg
+)
+{
+    std::vector<bool> results(recs.size(),false);
+    if (recs.size()==0)
+    {
+        return results;
+    }
+
+    // The hash checks cannot be combined, only those signatures that pass
+    // go on to the pairing checks
+    std::vector<bool> hash_ok=check_signature_hashes(recs);
+    // A credential with a point at infinity (or not on the curve) would
+    // add nothing to the combined check, so it fails here
+    std::vector<Batch_entry> entries(recs.size());
+    std::vector<size_t> idx;
+    idx.reserve(recs.size());
+    for (size_t i=0;i<recs.size();++i)
+    {
+        if (!hash_ok[i])
+        {
+            LOG_DEBUG(1,"Signature {} failed the hash check",i);
+            continue;
+        }
+        ECP pts[4];
+        if (!daa_credential_to_ecps(recs[i].r_cre,pts))
+        {
+            LOG_DEBUG(1,"Signature {} has a credential point at infinity or not on the curve",i);
+            continue;
+        }
+        Batch_entry& be=entries[i];
+        ECP_copy(&be.a,&pts[0]);
+        ECP_copy(&be.b,&pts[1]);
+        ECP_copy(&be.c,&pts[2]);
+        ECP_copy(&be.ad,&pts[3]);
+        ECP_add(&be.ad,&be.a);
+        idx.push_back(i);
+    }
+    if (idx.size()==0)
+    {
+        return results;
+    }
+
+    bisect_pairing_checks(recs,ipk,entries,idx,0,idx.size(),rbg,results);
+
+    return results;
+}
@@ -40,6 +40,7 @@
 
 #pragma once
 
+#include <vector>
 #include "Mechanism_4_data.h"
 #include "G2_utils.h"
 #include "Amcl_utils.h"
@@ -48,7 +49,71 @@
 
 Issuer_public_keys amcl_calculate_public_keys(Issuer_private_keys const& pks);
 
+// A point in G2 and a point in G1, the pairing is e(first,second)
+using Pairing_pair=std::pair<ECP2*,ECP*>;
+using Pairing_pairs=std::vector<Pairing_pair>;
+
+// The coefficients of a line function before it is evaluated at a point in
+// G1. The line is: (cy.P_y + c0) + (cx.P_x) placed according to the twist.
+struct Line_coeffs
+{
+	FP256BN::FP2 cy;
+	FP256BN::FP2 c0;
+	FP256BN::FP2 cx;
+};
+
+// All of the lines needed for the Miller loop of a point in G2. They only
+// depend on the point in G2 and so can be calculated once for fixed points.
+// Empty for the point at infinity.
+using Prepared_g2_point=std::vector<Line_coeffs>;
+
+Prepared_g2_point prepare_g2_point(ECP2* q);
+
+using Prepared_pairing_pair=std::pair<Prepared_g2_point const*,ECP*>;
+using Prepared_pairing_pairs=std::vector<Prepared_pairing_pair>;
+
+// The Miller loops for the product of pairings e(Q_1,P_1)...e(Q_n,P_n), all
+// done together so there is only one squaring of the result for each step.
+// Pairs including the point at infinity are ignored. No final exponentiation.
+void amcl_prepared_miller_loop(FP12* r, Prepared_pairing_pairs const& pairs);
+
+void amcl_multi_miller_loop(FP12* r, Pairing_pairs const& pairs);
+
+// The product of pairings, with a single final exponentiation
+void amcl_multi_pairing(FP12* r, Pairing_pairs const& pairs);
+
+// Checks if the product of pairings is the identity in GT
+bool amcl_pairing_product_is_one(Pairing_pairs const& pairs);
+
+bool amcl_prepared_product_is_one(Prepared_pairing_pairs const& pairs);
+
+// The prepared G2 generator and issuer public keys, for verifiers that check
+// many credentials from the same issuer
+class Prepared_issuer_keys
+{
+public:
+	explicit Prepared_issuer_keys(Issuer_public_keys const& ipk);
+	Prepared_g2_point const& p2() const {return p2_;}
+	Prepared_g2_point const& x() const {return x_;}
+	Prepared_g2_point const& y() const {return y_;}
+private:
+	Prepared_g2_point p2_;
+	Prepared_g2_point x_;
+	Prepared_g2_point y_;
+};
+
+// The four points of the credential. False if any of them is the point at
+// infinity, or was not on the curve (AMCL makes these the point at
+// infinity), as the pairing checks would ignore it.
+bool daa_credential_to_ecps(Daa_credential const& cre, ECP pts[4]);
+
+// False for a credential with a point at infinity or not on the curve
 bool check_daa_pairings(
 Daa_credential const& cre,
 Issuer_public_keys const& issuer_keys
 );
+
+bool check_daa_pairings(
+Daa_credential const& cre,
+Prepared_issuer_keys const& issuer_keys
+);
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* File:        Basename_cache.h
+* Description: A cache of the points calculated from basenames
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+
+const size_t default_basename_cache_size=64;
+
+// The points for a basename
+struct Basename_points
+{
+	G1_point map_pt;    // (s_2,y_2), as point_from_basename
+	G1_point pt_j;      // J=(H(s_2) mod p,y_2)
+};
+
+// A thread-safe, bounded cache of the points for the most recently used
+// basenames. When it is full the least recently used basename is dropped.
+class Basename_cache
+{
+public:
+	explicit Basename_cache(size_t capacity=default_basename_cache_size);
+	Basename_cache(Basename_cache const& bc)=delete;
+	Basename_cache& operator=(Basename_cache const& bc)=delete;
+	// The points for bsn, which must not be empty, calculated on a miss.
+	// Throws if no point is found for bsn.
+	Basename_points get(Byte_buffer const& bsn);
+	size_t size() const;
+	uint64_t hits() const;
+	uint64_t misses() const;
+	void clear();
+
+private:
+	using Lru_list=std::list<std::pair<Byte_buffer,Basename_points>>;
+
+	size_t const capacity_;
+	mutable std::mutex cache_mutex_;
+	Lru_list lru_;      // Most recently used first
+	std::map<Byte_buffer,Lru_list::iterator> index_;
+	uint64_t hits_;
+	uint64_t misses_;
+};
+
+// The cache shared by the signers and verifiers in a program
+Basename_cache& basename_cache();
@@ -0,0 +1,113 @@
+/*******************************************************************************
+* File:        Credential_pool.h
+* Description: A pool of pre-randomised DAA credentials for signing
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "Get_random_bytes.h"
+#include "Daa_credential.h"
+
+const size_t default_credential_pool_size=8;
+
+// A pool is either kept full, or only filled once, for a program that signs
+// once and should not be randomising while it signs or waiting for a spare
+// randomisation when it exits
+enum class Pool_refill {continuous, once};
+
+// Keeps a number of randomised copies of a DAA credential ready, so that a
+// signature (sign, certify or quote) does not have to wait for the four
+// point multiplications of randomise_daa_credential. A background thread
+// refills the pool whenever it is below its capacity. Each credential is
+// handed out once.
+class Credential_pool
+{
+public:
+	struct Metrics
+	{
+		size_t depth;               // Credentials ready now
+		size_t capacity;
+		uint64_t produced;          // By the refill thread
+		uint64_t taken;
+		uint64_t misses;            // Takes that found the pool empty
+		float refill_per_sec;       // Credentials per second of refill time
+	};
+
+	Credential_pool(
+	Daa_credential const& cre,
+	size_t capacity=default_credential_pool_size,
+	Pool_refill refill=Pool_refill::continuous
+	);
+	Credential_pool(Credential_pool const& cp)=delete;
+	Credential_pool& operator=(Credential_pool const& cp)=delete;
+	// Stops the refill thread, after the credential it is working on
+	~Credential_pool();
+	// A randomised credential. If the pool is empty one is made on the
+	// calling thread with rbg, and counted as a miss.
+	Daa_credential take(Random_byte_generator& rbg);
+	// Blocks until the pool is full, e.g. before timing, or the refill thread
+	// has stopped
+	void wait_until_full();
+	Metrics metrics() const;
+
+private:
+	Daa_credential const cre_;
+	size_t const capacity_;
+	Pool_refill const refill_;
+
+	mutable std::mutex pool_mutex_;
+	std::condition_variable refill_cv_;
+	std::condition_variable full_cv_;
+	std::deque<Daa_credential> pool_;
+	bool stopping_;
+	uint64_t produced_;
+	uint64_t taken_;
+	uint64_t misses_;
+	std::chrono::steady_clock::duration refill_time_;
+	std::thread refiller_;
+
+	void run_refill();
+};
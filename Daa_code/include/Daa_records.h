@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File:        Daa_records.h
+* Description: Reads and checks the signature and attestation records written by the DAA programs
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Issuer_public_keys.h"
+#include "Daa_credential.h"
+#include "Verify_daa_batch.h"
+
+// The data read from an attestation file produced by daa_certify_key or
+// daa_quote_pcr
+struct Daa_attestation_record
+{
+    std::string type;           // certify or quote
+    Byte_buffer label;
+    Byte_buffer key_pd;         // The public data of the certified key
+    Byte_buffer cert;           // The marshalled TPMS_ATTEST
+    Byte_buffer bsn;            // empty if no basename was used
+    G1_point pt_j;
+    G1_point pt_k;
+    Daa_credential r_cre;       // the randomised credential (R,S,T,W)
+    Byte_buffer nc;
+    Byte_buffer sig_s;
+    Byte_buffer h2;
+};
+
+// Read a record in the format written to the signature and attestation
+// files. bsn, J and K are only present if a basename was used. The issuer's
+// public keys are returned as read, so the caller can use them to find keys
+// that it has already prepared. Throws if the record is incomplete.
+Daa_signature_record read_daa_signature_record(
+std::istream& is,
+bool use_basename,
+Byte_buffer& serialised_ipk
+);
+
+Daa_attestation_record read_daa_attestation_record(
+std::istream& is,
+bool use_basename,
+Byte_buffer& serialised_ipk
+);
+
+// Checks J (if a basename is used) and the hash h_2 for an attestation, but
+// NOT the credential pairings or the attested data itself
+bool verify_daa_attestation_hash(Daa_attestation_record const& rec);
@@ -0,0 +1,161 @@
+/*******************************************************************************
+* File:        Daa_stream_verifier.h
+* Description: Verifies a stream of DAA signature and attestation records
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Byte_buffer.h"
+#include "Daa_records.h"
+
+enum class Record_type {signature,certify,quote};
+enum class Record_format {text,wire};
+
+// A record to verify, with the id that its result is returned with. For a
+// wire record the type and basename are read from the record itself.
+struct Verify_request
+{
+    std::string id;
+    Record_format format;
+    Record_type type;
+    bool use_basename;
+    std::string body;       // The contents of a signature or attestation file
+};
+
+// Reads requests framed as a header line
+//  <id> <sign|certify|quote> <bsn|no_bsn> <length>
+// followed by length bytes of the record, e.g. the contents of a file written
+// by daa_sign_message, or
+//  <id> wire <length>
+// followed by a record in the binary format (see Daa_wire_format.h)
+class Frame_reader
+{
+public:
+    explicit Frame_reader(int fd) : fd_(fd), pos_(0) {}
+    // False at the end of the input. Throws if a frame is badly formed.
+    bool next(Verify_request& req);
+
+private:
+    int fd_;
+    std::string buf_;
+    size_t pos_;
+
+    bool fill();
+};
+
+// Writes a line for each result, "<id> ok" or "<id> failed <reason>", and
+// counts the results still to come so that the output can be closed once
+// they have all been written
+class Result_writer
+{
+public:
+    explicit Result_writer(int fd) : fd_(fd), pending_(0) {}
+    void expect();
+    void write(std::string const& id, std::string const& failure);
+    void wait_for_results();
+
+private:
+    int fd_;
+    std::mutex writer_mutex_;
+    std::condition_variable writer_cv_;
+    size_t pending_;
+};
+
+// Checks the attested data in an attestation, e.g. the certified key's name
+using Attestation_data_check=std::function<bool(Daa_attestation_record const&)>;
+
+struct Stream_verifier_stats
+{
+    uint64_t requests;
+    uint64_t verified;
+    uint64_t failed;
+};
+
+// Verifies records on a pool of worker threads. The state that does not
+// depend on a record is kept between records: the prepared issuer keys (for
+// up to eight issuers), the points for each basename and the curve tables.
+// submit() waits if the workers are far behind.
+class Stream_verifier
+{
+public:
+    // number_of_threads=0 uses one thread for each core. Without a check
+    // attestations fail.
+    explicit Stream_verifier(size_t number_of_threads=0, Attestation_data_check check=Attestation_data_check());
+    Stream_verifier(Stream_verifier const& sv)=delete;
+    Stream_verifier& operator=(Stream_verifier const& sv)=delete;
+    // Waits for the records that have been submitted
+    ~Stream_verifier();
+    void submit(Verify_request req, std::shared_ptr<Result_writer> const& writer);
+    size_t number_of_threads() const {return workers_.size();}
+    Stream_verifier_stats stats() const;
+    // Verifies a record on the calling thread, returning an empty string if
+    // it verifies, otherwise the reason that it failed
+    std::string verify(Verify_request const& req);
+
+private:
+    using Issuer_keys_ptr=std::shared_ptr<Prepared_issuer_keys const>;
+
+    Attestation_data_check const check_;
+
+    mutable std::mutex jobs_mutex_;
+    std::condition_variable jobs_cv_;
+    std::condition_variable space_cv_;
+    std::deque<std::function<void()>> jobs_;
+    bool stopping_;
+    Stream_verifier_stats stats_;
+    std::vector<std::thread> workers_;
+
+    std::mutex keys_mutex_;
+    std::map<Byte_buffer,Issuer_keys_ptr> issuer_keys_;
+
+    // The keys are found using either form of the issuer's public keys
+    Issuer_keys_ptr prepared_issuer_keys(Byte_buffer const& serialised_ipk, std::function<Issuer_public_keys()> const& decode);
+    std::string verify_signature(Daa_signature_record const& rec, std::function<Issuer_keys_ptr()> const& keys);
+    std::string verify_attestation(Daa_attestation_record const& rec, std::function<Issuer_keys_ptr()> const& keys);
+    void run_worker();
+};
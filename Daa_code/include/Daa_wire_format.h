@@ -0,0 +1,124 @@
+/*******************************************************************************
+* File:        Daa_wire_format.h
+* Description: A binary format for the DAA keys, credentials, signatures and attestations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <iostream>
+#include <string>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "G2_utils.h"
+#include "Issuer_public_keys.h"
+#include "Daa_credential.h"
+#include "Daa_records.h"
+
+// The binary form of the records that are otherwise written as lines of hex.
+// A record is a 12 byte header:
+//  "DAAW", version, type, flags, 0, length of the rest (4 bytes, big endian)
+// then a fixed part, whose layout depends only on the type and flags:
+//  issuer public keys  - 4 slots for each of the two G2 points
+//  J, K                - 2 slots each, only if a basename is used
+//  credential          - 2 slots for each of R, S, T and W
+//  n, s, h_2           - a slot each (signatures and attestations only)
+// and last the variable length fields, each a 4 byte length and the bytes:
+//  sign                - message [, basename]
+//  certify, quote      - label, key public data, attestation data [, basename]
+// A slot is a length (at most 32) and 32 bytes, with the value at the end, so
+// that the values are returned exactly as they were written.
+const uint8_t daa_wire_version=1;
+const size_t daa_wire_header_size=12;
+const size_t daa_wire_slot_size=1+component_size;
+const size_t daa_wire_g1_point_size=2*daa_wire_slot_size;
+const size_t daa_wire_g2_point_size=4*daa_wire_slot_size;
+const size_t daa_wire_issuer_keys_size=2*daa_wire_g2_point_size;
+const size_t daa_wire_credential_size=4*daa_wire_g1_point_size;
+
+enum class Daa_wire_type : uint8_t {issuer_public_keys=1,credential=2,sign=3,certify=4,quote=5};
+
+// Flags
+const uint8_t daa_wire_basename=0x01;
+
+// A parsed record, whose fields are views of the buffer that it was parsed
+// from. The fields not used by the type are empty. The fixed size
+// blocks (issuer_keys, credential, pt_j, pt_k) are decoded with the
+// functions below; sig holds n (n_M or n_C), s and h_2.
+struct Daa_wire_record
+{
+    Daa_wire_type type;
+    bool use_basename;
+    Byte_view issuer_keys;
+    Byte_view pt_j;
+    Byte_view pt_k;
+    Byte_view credential;
+    std::array<Byte_view,3> sig;
+    Byte_view msg;              // The message for sign, the label for certify and quote
+    Byte_view key_pd;
+    Byte_view cert;
+    Byte_view bsn;
+};
+
+// Checks the header, the lengths and the slots, then returns the fields
+// without copying them. Throws if the record is badly formed.
+Daa_wire_record parse_daa_wire_record(Byte_const_ptr data, size_t size);
+Daa_wire_record parse_daa_wire_record(Byte_buffer const& bb);
+
+// Decode the fixed size blocks of a parsed record
+G1_point wire_g1_point(Byte_view block);
+Issuer_public_keys wire_issuer_public_keys(Byte_view block);
+Daa_credential wire_daa_credential(Byte_view block);
+
+// Convert a parsed record to the records used by the verifiers. The issuer's
+// public keys are left in the wire record.
+Daa_signature_record wire_to_signature_record(Daa_wire_record const& rec);
+Daa_attestation_record wire_to_attestation_record(Daa_wire_record const& rec);
+
+Byte_buffer wire_encode_issuer_public_keys(Issuer_public_keys const& ipk);
+Byte_buffer wire_encode_daa_credential(Daa_credential const& cre);
+
+// Converts the contents of a signature or attestation file, as written by
+// daa_sign_message, daa_certify_key or daa_quote_pcr, to a wire record.
+// Throws if the record is incomplete.
+Byte_buffer daa_text_record_to_wire(std::istream& is, bool use_basename);
+
+// Writes a parsed record in the text format: a signature or attestation file,
+// or the hex line for issuer public keys and credentials
+void daa_wire_record_to_text(std::ostream& os, Daa_wire_record const& rec);
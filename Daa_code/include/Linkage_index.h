@@ -0,0 +1,114 @@
+/*******************************************************************************
+* File:        Linkage_index.h
+* Description: An index of the pseudonyms (K) seen with each basename
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+
+const uint64_t default_linkage_index_capacity=1<<20;
+
+// Signatures with the same basename and the same K=[f]J were made by the
+// same DAA key. A (basename,K) pair is identified by the first 96 bits of
+// SHA-256(len(bsn)||bsn||K.x||K.y), with K's coordinates padded.
+struct Linkage_fingerprint
+{
+	uint64_t hi;
+	uint32_t lo;
+};
+
+Linkage_fingerprint linkage_fingerprint(Byte_buffer const& bsn, G1_point const& pt_k);
+
+// An open-addressing hash table counting the signatures seen for each
+// (basename,K) pair. Each entry is 16 bytes, the fingerprint and a count.
+// The table is split into segments, each with its own lock, so threads
+// recording or looking up different pseudonyms rarely wait for each other.
+// The table is either in memory or a file mapped into memory, so an index
+// is kept between runs. A process holds an exclusive lock on the file while
+// it has the index open, so verifiers in other processes wait their turn.
+// The file is in the machine's byte order.
+// The capacity is fixed when the index is made; inserting into a segment
+// that is 7/8 full throws.
+class Linkage_index
+{
+public:
+	// An index in memory
+	explicit Linkage_index(uint64_t capacity=default_linkage_index_capacity);
+	// Opens the index in filename, making it with the given capacity if the
+	// file does not exist. Throws if the file is not a linkage index.
+	Linkage_index(std::string const& filename, uint64_t capacity=default_linkage_index_capacity);
+	Linkage_index(Linkage_index const& li)=delete;
+	Linkage_index& operator=(Linkage_index const& li)=delete;
+	~Linkage_index();
+	// Records one more signature for the pseudonym and returns the number
+	// recorded, including this one. Counts saturate at UINT32_MAX.
+	uint32_t insert_or_get_count(Linkage_fingerprint const& fp);
+	uint32_t insert_or_get_count(Byte_buffer const& bsn, G1_point const& pt_k);
+	// The number of signatures recorded for the pseudonym, 0 if it is new
+	uint32_t count(Linkage_fingerprint const& fp) const;
+	uint32_t count(Byte_buffer const& bsn, G1_point const& pt_k) const;
+	// The number of different pseudonyms
+	uint64_t size() const;
+	uint64_t capacity() const;
+	// Writes a mapped index back to its file
+	void flush();
+
+private:
+	struct Header;
+	struct Entry;
+
+	void map_index(int fd, uint64_t capacity, bool is_new);
+	void check_header() const;
+	uint32_t segment_of(Linkage_fingerprint const& fp) const;
+	// The entry for fp in its segment, or the empty entry where it would go
+	Entry* find_entry(Linkage_fingerprint const& fp) const;
+
+	int fd_;
+	void* map_;
+	size_t map_size_;
+	Header* header_;
+	Entry* entries_;
+	uint64_t segment_capacity_;
+	std::unique_ptr<std::mutex[]> segment_mutexes_;
+};
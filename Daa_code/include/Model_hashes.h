@@ -44,12 +44,51 @@
 #include <iostream>
 #include <string>
 #include <array>
+#include <vector>
 #include "Byte_buffer.h"
 #include "G1_utils.h"
 #include "G2_utils.h"
 #include "Daa_credential.h"
 #include "Sha.h"
 #include "bnp256_param.h"
+#include "Scalar_bnp256.h"
+
+// Hashes the values making up a transcript as they are added, with each
+// point coordinate padded as g1_point_concat would, so that the digest is
+// that of the concatenation without building it
+class Transcript
+{
+public:
+    Transcript& add(Byte_view bv) {hasher_.update(bv);return *this;}
+    Transcript& add(G1_point const& pt);
+    Transcript& add(Daa_credential const& cre);
+    Byte_buffer digest() {return hasher_.finish();}
+    // The same as hash_to_scalar of the concatenation
+    Scalar_bnp256 to_scalar();
+
+private:
+    Sha256_hasher hasher_;
+};
+
+// Collects a set of independent transcripts, each begun with next(), so that
+// they can be hashed together by sha256_multi
+class Transcript_batch
+{
+public:
+    Transcript_batch& next() {ends_.push_back(data_.size());return *this;}
+    Transcript_batch& add(Byte_view bv);
+    Transcript_batch& add(G1_point const& pt);
+    Transcript_batch& add(Daa_credential const& cre);
+    // Drops the last transcript, if it could not be completed
+    void discard_last();
+    size_t size() const {return ends_.size();}
+    // The digest of each transcript, in the order they were begun
+    std::vector<Byte_buffer> digests() const;
+
+private:
+    Byte_buffer data_;
+    std::vector<size_t> ends_;
+};
 
 Byte_buffer host_str(G2_point const& x, G2_point const& y, Byte_buffer const& key, Byte_buffer const& ek);
 
@@ -0,0 +1,123 @@
+/*******************************************************************************
+* File:        Revocation_check.h
+* Description: Checks basename signatures against a list of revoked DAA secret keys
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+
+const size_t default_revocation_table_capacity=16;
+// A basename is common, and gets a table, when it has been checked this often
+const uint32_t default_revocation_table_threshold=2;
+
+struct Revocation_stats
+{
+	uint64_t checks;
+	uint64_t table_checks;      // Answered from a basename's table
+	uint64_t revoked;
+	uint64_t points;            // [f_i]J calculated, including for tables
+	double check_microseconds;  // Total time for all of the checks
+};
+
+// A signature with a basename was made with a revoked DAA key f_i if
+// K=[f_i]J. For a basename seen only once each [f_i]J is calculated, from a
+// fixed-base table for J, on a number of threads, stopping as soon as one
+// matches K. Once a basename is common the [f_i]J are all calculated and
+// kept, by a hash of their x-coordinate and the parity of y, in a table
+// for the basename, so a check is a lookup and one multiplication to confirm
+// each key with that hash. The tables for the most recently used
+// basenames are kept.
+class Revocation_checker
+{
+public:
+	// number_of_threads=0 uses one thread for each core
+	explicit Revocation_checker(
+	std::vector<Byte_buffer> const& revoked_keys,
+	size_t number_of_threads=0,
+	size_t table_capacity=default_revocation_table_capacity,
+	uint32_t table_threshold=default_revocation_table_threshold
+	);
+	Revocation_checker(Revocation_checker const& rc)=delete;
+	Revocation_checker& operator=(Revocation_checker const& rc)=delete;
+	// True if K=[f_i]J for one of the revoked keys. J must be the point for
+	// bsn, as checked by the verifier.
+	bool is_revoked(Byte_buffer const& bsn, G1_point const& pt_j, G1_point const& pt_k);
+	size_t size() const {return revoked_keys_.size();}
+	size_t number_of_threads() const {return number_of_threads_;}
+	Revocation_stats stats() const;
+
+private:
+	// Hash of [f_i]J -> i, for every i as hashes can be the same
+	using Revocation_table=std::unordered_multimap<uint64_t,uint32_t>;
+	using Table_ptr=std::shared_ptr<Revocation_table const>;
+	using Lru_list=std::list<std::pair<Byte_buffer,Table_ptr>>;
+
+	std::vector<Byte_buffer> const revoked_keys_;
+	size_t const number_of_threads_;
+	size_t const table_capacity_;
+	uint32_t const table_threshold_;
+
+	mutable std::mutex checker_mutex_;
+	Lru_list lru_;      // Most recently used first
+	std::map<Byte_buffer,Lru_list::iterator> index_;
+	std::map<Byte_buffer,uint32_t> seen_;       // Basenames without tables
+	Revocation_stats stats_;
+
+	// The table for bsn, or null if bsn is not common yet
+	Table_ptr find_table(Byte_buffer const& bsn);
+	// Counts a check of bsn without a table, returning the count
+	uint32_t note_seen(Byte_buffer const& bsn);
+	void add_table(Byte_buffer const& bsn, Table_ptr const& table);
+	Table_ptr make_table(G1_point const& pt_j) const;
+	// Returns the number of points calculated
+	uint64_t scan(G1_point const& pt_j, G1_point const& pt_k, bool& revoked) const;
+	size_t threads_for(size_t n_keys) const;
+};
+
+// Reads the revoked keys, one hex value per line
+std::vector<Byte_buffer> read_revocation_list(std::string const& filename);
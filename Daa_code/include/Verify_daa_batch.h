@@ -0,0 +1,89 @@
+/*******************************************************************************
+* File:        Verify_daa_batch.h
+* Description: Batch verification of DAA signatures made with the same issuer keys
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include "Byte_buffer.h"
+#include "Get_random_bytes.h"
+#include "G1_utils.h"
+#include "Openssl_verify.h"
+#include "Issuer_public_keys.h"
+#include "Daa_credential.h"
+#include "Amcl_pairings.h"
+
+// The data read from a signature file produced by daa_sign_message
+struct Daa_signature_record
+{
+    Byte_buffer msg_digest;     // sha256 of the signed message
+    Byte_buffer bsn;            // empty if no basename was used
+    G1_point pt_j;
+    G1_point pt_k;
+    Daa_credential r_cre;       // the randomised credential (R,S,T,W)
+    Daa_signature sig;          // n_M, s, h_2
+};
+
+using Daa_signature_records=std::vector<Daa_signature_record>;
+
+// Size of the random exponents used to combine the pairing checks
+const size_t batch_exponent_bytes=16;
+
+// Checks J (if a basename is used) and the hash h_2 for a single signature,
+// but NOT the credential pairings
+bool verify_daa_signature_hash(Daa_signature_record const& rec);
+
+// Verifies a set of signatures that use the same issuer public keys. The hash
+// checks are done for each signature, but with the hashing for all of them
+// done together by sha256_multi. The pairing checks for the credentials are
+// combined, using small random exponents, into a single product of pairings
+// with one final exponentiation. If the combined check fails the set is
+// bisected to find the bad signatures. Returns the result for each signature.
+std::vector<bool> verify_daa_signatures_batch(
+Daa_signature_records const& recs,
+Issuer_public_keys const& ipk,
+Random_byte_generator& rbg
+);
+
+// As above, using the prepared issuer keys
+std::vector<bool> verify_daa_signatures_batch(
+Daa_signature_records const& recs,
+Prepared_issuer_keys const& ipk,
+Random_byte_generator& rbg
+);
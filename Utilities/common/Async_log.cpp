@@ -0,0 +1,320 @@
+/*******************************************************************************
+* File:        Async_log.cpp
+* Description: A log that writes its records on a background thread
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include "Async_log.h"
+
+namespace
+{
+// Collects a thread's os() output and queues it a line at a time. The
+// characters of a line after the first Log_record::data_size are dropped.
+class Line_buffer : public std::streambuf
+{
+public:
+	Line_buffer() : log_(nullptr), size_(0), truncated_(false) {}
+	void set_log(Async_log* log)
+	{
+		if (log!=log_)
+		{
+			size_=0;    // A part line for another log is dropped
+			truncated_=false;
+			log_=log;
+		}
+	}
+	~Line_buffer()=default;
+
+protected:
+	int overflow(int c)
+	{
+		if (c!=traits_type::eof())
+		{
+			char ch=static_cast<char>(c);
+			append(&ch,1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize xsputn(char const* s, std::streamsize n)
+	{
+		append(s,static_cast<size_t>(n));
+		return n;
+	}
+
+	int sync()
+	{
+		if (size_>0 || truncated_)
+		{
+			queue_line();
+		}
+		return 0;
+	}
+
+private:
+	void append(char const* s, size_t n)
+	{
+		while (n>0)
+		{
+			char const* nl=static_cast<char const*>(std::memchr(s,'\n',n));
+			size_t len=(nl!=nullptr)?nl-s:n;
+			size_t copied=(len<sizeof(line_)-size_)?len:sizeof(line_)-size_;
+			std::memcpy(line_+size_,s,copied);
+			size_+=copied;
+			truncated_|=(copied<len);
+			s+=len;
+			n-=len;
+			if (nl!=nullptr)
+			{
+				++s;
+				--n;
+				queue_line();
+			}
+		}
+	}
+
+	void queue_line()
+	{
+		if (log_!=nullptr)
+		{
+			Log_record r;
+			make_text_record(r,line_,size_);
+			r.truncated=truncated_;
+			log_->write_record(r);
+		}
+		size_=0;
+		truncated_=false;
+	}
+
+	Async_log* log_;
+	size_t size_;
+	bool truncated_;
+	char line_[Log_record::data_size];
+};
+
+class Line_stream : public std::ostream
+{
+public:
+	Line_stream() : std::ostream(&buffer_) {}
+	std::ostream& attach(Async_log* log)
+	{
+		buffer_.set_log(log);
+		return *this;
+	}
+
+private:
+	Line_buffer buffer_;
+};
+
+size_t round_up_to_power_of_2(size_t n)
+{
+	size_t p=2;
+	while (p<n)
+	{
+		p<<=1;
+	}
+	return p;
+}
+}
+
+Async_log::Async_log(Log_ptr sink, size_t capacity) :
+sink_(std::move(sink)),
+mask_(round_up_to_power_of_2(capacity)-1),
+slots_(new Slot[mask_+1]),
+head_(0),
+dropped_(0),
+waiting_(false),
+stopping_(false),
+written_(0),
+tail_(0),
+time_seconds_(-1)
+{
+	for (size_t i=0;i<=mask_;++i)
+	{
+		slots_[i].sequence.store(i,std::memory_order_relaxed);
+	}
+	thread_=std::thread(&Async_log::drain,this);
+}
+
+Async_log::~Async_log()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_=true;
+	}
+	wake_.notify_one();
+	thread_.join();
+}
+
+std::ostream& Async_log::os()
+{
+	thread_local Line_stream stream;
+	return stream.attach(this);
+}
+
+void Async_log::write_to_log(std::string str)
+{
+	size_t start=0;
+	while (start<str.size())
+	{
+		size_t end=str.find('\n',start);
+		if (end==std::string::npos)
+		{
+			end=str.size();
+		}
+		Log_record r;
+		make_text_record(r,str.data()+start,end-start);
+		write_record(r);
+		start=end+1;
+	}
+}
+
+void Async_log::write_record(Log_record const& record)
+{
+	if (!try_push(record))
+	{
+		dropped_.fetch_add(1,std::memory_order_relaxed);
+	}
+}
+
+// The ring is D. Vyukov's bounded queue: a slot's sequence number says
+// whether it is free for the producer at that position, or holds a record
+// for the consumer
+bool Async_log::try_push(Log_record const& record)
+{
+	size_t pos=head_.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true)
+	{
+		slot=&slots_[pos&mask_];
+		size_t seq=slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff=static_cast<intptr_t>(seq)-static_cast<intptr_t>(pos);
+		if (diff==0)
+		{
+			if (head_.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff<0)
+		{
+			return false;   // Full
+		}
+		else
+		{
+			pos=head_.load(std::memory_order_relaxed);
+		}
+	}
+	slot->record=record;
+	slot->sequence.store(pos+1,std::memory_order_release);
+	// A missed wake up is only a delay, the drain thread also wakes on a timer
+	if (waiting_.load())
+	{
+		wake_.notify_one();
+	}
+	return true;
+}
+
+bool Async_log::format_next(std::string& batch)
+{
+	Slot& slot=slots_[tail_&mask_];
+	if (slot.sequence.load(std::memory_order_acquire)!=tail_+1)
+	{
+		return false;
+	}
+	// Each record is a line. The time is only to the second, so it is
+	// formatted once a second.
+	Log_record const& r=slot.record;
+	std::chrono::system_clock::duration d(r.time);
+	int64_t seconds=std::chrono::duration_cast<std::chrono::seconds>(d).count();
+	if (seconds!=time_seconds_)
+	{
+		time_text_=log_record_time(r)+": ";
+		time_seconds_=seconds;
+	}
+	batch+=time_text_;
+	append_log_record(batch,r);
+	slot.sequence.store(tail_+mask_+1,std::memory_order_release);
+	++tail_;
+	return true;
+}
+
+void Async_log::flush()
+{
+	size_t target=head_.load();
+	std::unique_lock<std::mutex> lock(mutex_);
+	wake_.notify_one();
+	flushed_.wait(lock,[&]{return written_>=target;});
+}
+
+void Async_log::drain()
+{
+	std::string batch;
+	while (true)
+	{
+		size_t n=0;
+		while (n<max_batch && format_next(batch))
+		{
+			++n;
+		}
+		if (n>0)
+		{
+			sink_->write_to_log(batch);
+			batch.clear();
+			std::lock_guard<std::mutex> lock(mutex_);
+			written_=tail_;
+			flushed_.notify_all();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (stopping_)
+		{
+			break;
+		}
+		waiting_.store(true);
+		if (slots_[tail_&mask_].sequence.load(std::memory_order_acquire)!=tail_+1)
+		{
+			wake_.wait_for(lock,std::chrono::milliseconds(10));
+		}
+		waiting_.store(false);
+	}
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************
+* File:        Bnp256_map_to_point.cpp
+* Description: Map-to-point for BN_P256 using fixed-width AMCL field arithmetic
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <stdexcept>
+#include <vector>
+#include "Byte_buffer.h"
+#include "Sha.h"
+#include "G1_utils.h"
+#include "Amcl_utils.h"
+#include "Bnp256_map_to_point.h"
+
+using namespace FP256BN;
+using namespace FP256BN_BIG;
+
+namespace
+{
+// Remove leading zeros to match the output from BN_bn2bin
+Byte_buffer strip_leading_zeros(Byte_buffer const& bb)
+{
+	size_t start=0;
+	while (start<bb.size() && bb[start]==0)
+	{
+		++start;
+	}
+	return bb.get_part(start,bb.size()-start);
+}
+
+class Bnp256_mapper
+{
+public:
+	Bnp256_mapper()
+	{
+		BIG_rcopy(p_,Modulus);
+	}
+	G1_point map(Byte_buffer const& initial_value, uint32_t max_iter)
+	{
+		for (uint32_t counter=0;counter<max_iter;++counter)
+		{
+			Byte_buffer s_2=uint32_to_bb(counter)+initial_value;
+			bb_to_big(sha256_bb(s_2),x_big_);
+			BIG_mod(x_big_,p_);
+			FP_nres(&x_,x_big_);
+			ECP_rhs(&ysq_,&x_);
+			if (FP_iszilch(&ysq_))
+			{
+				// x^3+b=0 gives the point (x_2,0)
+				return std::make_pair(s_2,Byte_buffer());
+			}
+			if (!FP_qr(&ysq_))
+			{
+				continue;
+			}
+			FP_sqrt(&y_,&ysq_);
+			FP_redc(y_big_,&y_);
+			return std::make_pair(s_2,strip_leading_zeros(big_to_bb(y_big_)));
+		}
+		throw(std::runtime_error("bnp256_map_to_point: failed to find a point"));
+	}
+private:
+	BIG p_;
+	BIG x_big_;
+	BIG y_big_;
+	FP x_;
+	FP ysq_;
+	FP y_;
+};
+}
+
+G1_point bnp256_map_to_point(
+Byte_buffer const& initial_value,
+uint32_t max_iter
+)
+{
+	Bnp256_mapper mapper;
+	return mapper.map(initial_value,max_iter);
+}
+
+std::vector<G1_point> bnp256_map_to_points(
+std::vector<Byte_buffer> const& initial_values,
+uint32_t max_iter
+)
+{
+	Bnp256_mapper mapper;
+	std::vector<G1_point> points;
+	points.reserve(initial_values.size());
+	for (auto const& iv : initial_values)
+	{
+		points.push_back(mapper.map(iv,max_iter));
+	}
+	return points;
+}
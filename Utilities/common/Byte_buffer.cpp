@@ -49,155 +49,269 @@
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "Byte_buffer.h"
 
-Byte_buffer::Byte_buffer()
+namespace
 {
-    initialise();
+int hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
 }
 
-Byte_buffer::Byte_buffer(std::initializer_list<Byte> il) : byte_buf_(il) {}
+Byte_view Byte_view::subview(size_t start, size_t length) const
+{
+    if (start > size_ || length > size_ - start) {
+        throw(std::runtime_error("Invalid parameters for Byte_view::subview"));
+    }
+    return Byte_view(data_ + start, length);
+}
 
-Byte_buffer::Byte_buffer(size_t const sz, Byte const b)
+bool operator==(Byte_view lhs, Byte_view rhs)
 {
-    byte_buf_.assign(sz, b);
+    return lhs.size() == rhs.size() && (lhs.size() == 0 || memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
 }
 
-Byte_buffer::Byte_buffer(std::string const &str)
+Byte_buffer::Byte_buffer(Byte_buffer const &bb) : Byte_buffer()
 {
-    initialise();
-    size_t buf_size = str.size();
-    byte_buf_.resize(buf_size);
-    for (size_t i = 0; i < buf_size; ++i) {
-        // Assumes the string is made up of 8 bit characters
-        byte_buf_[i] = static_cast<Byte>(str[i]);
+    append(bb.data_, bb.size_);
+}
+
+Byte_buffer::Byte_buffer(Byte_buffer &&bb) noexcept : Byte_buffer()
+{
+    *this = std::move(bb);
+}
+
+Byte_buffer &Byte_buffer::operator=(Byte_buffer const &bb)
+{
+    if (this != &bb) {
+        size_ = 0;
+        append(bb.data_, bb.size_);
     }
+    return *this;
+}
+
+Byte_buffer &Byte_buffer::operator=(Byte_buffer &&bb) noexcept
+{
+    if (this == &bb) {
+        return *this;
+    }
+    release();
+    if (bb.data_ != bb.inline_) {
+        // Take the allocation
+        data_ = bb.data_;
+        capacity_ = bb.capacity_;
+        bb.data_ = bb.inline_;
+        bb.capacity_ = inline_capacity;
+    } else {
+        data_ = inline_;
+        capacity_ = inline_capacity;
+        memcpy(inline_, bb.inline_, bb.size_);
+    }
+    size_ = bb.size_;
+    bb.size_ = 0;
+    return *this;
+}
+
+Byte_buffer::Byte_buffer(std::initializer_list<Byte> il) : Byte_buffer()
+{
+    append(il.begin(), il.size());
+}
+
+Byte_buffer::Byte_buffer(size_t const sz, Byte const b) : Byte_buffer()
+{
+    resize(sz);
+    memset(data_, b, sz);
+}
+
+Byte_buffer::Byte_buffer(std::string const &str) : Byte_buffer()
+{
+    // Assumes the string is made up of 8 bit characters
+    append(reinterpret_cast<Byte_const_ptr>(str.data()), str.size());
 }
 
-Byte_buffer::Byte_buffer(Bytes bv) : byte_buf_(std::move(bv)) {}
+Byte_buffer::Byte_buffer(Bytes const &bv) : Byte_buffer()
+{
+    append(bv.data(), bv.size());
+}
 
+Byte_buffer::Byte_buffer(Byte_view bv) : Byte_buffer()
+{
+    append(bv);
+}
 
-Byte_buffer::Byte_buffer(Hex_string const &hs)
+Byte_buffer::Byte_buffer(Hex_string const &hs) : Byte_buffer()
 {
-    initialise();
     size_t buf_size = hs.size() / 2;
-    byte_buf_.resize(buf_size);
+    resize(buf_size);
     std::string bstr;
     for (size_t i = 0; i < buf_size; ++i) {
         bstr = hs.hex_string().substr(2 * i, 2);
-        byte_buf_[i] = static_cast<Byte>(stoul(bstr, nullptr, hex_base));
+        data_[i] = static_cast<Byte>(stoul(bstr, nullptr, hex_base));
     }
 }
 
-Byte_buffer::Byte_buffer(const Byte *buf, size_t len)
+Byte_buffer::Byte_buffer(const Byte *buf, size_t len) : Byte_buffer()
 {
-    byte_buf_.resize(len);
-    memcpy(&byte_buf_[0],buf,len);
-    //for (int i = 0; i < len; ++i) {
-    //    byte_buf_[i] = buf[i];
-    //}
+    append(buf, len);
 }
 
 Byte_buffer Byte_buffer::get_part(size_t start, size_t length) const
 {
-    if (start + length > byte_buf_.size()) {
+    if (start + length > size_) {
         throw(std::runtime_error("Invalid parameters for Byte_buffer::get_part"));
     }
 
-    Byte_buffer bb(length, 0);
-    for (size_t i = 0; i < length; ++i) {
-        bb[i] = byte_buf_[i + start];
+    return Byte_buffer(data_ + start, length);
+}
+
+Byte_view Byte_buffer::view(size_t start, size_t length) const
+{
+    if (start + length > size_) {
+        throw(std::runtime_error("Invalid parameters for Byte_buffer::view"));
     }
 
-    return bb;
+    return Byte_view(data_ + start, length);
 }
 
 void Byte_buffer::set_part(size_t start, Byte_buffer const &part)
 {
-    if (start + part.size() > byte_buf_.size()) {
+    if (start + part.size() > size_) {
         throw(std::runtime_error("Invalid parameters for Byte_buffer::set_part"));
     }
 
-    for (size_t i = 0; i < part.size(); ++i) {
-        byte_buf_[i + start] = part[i];
+    memmove(data_ + start, part.data_, part.size_);
+}
+
+void Byte_buffer::grow(size_t min_capacity)
+{
+    size_t new_capacity = std::max(min_capacity, 2 * capacity_);
+    Byte_ptr new_data = new Byte[new_capacity];
+    memcpy(new_data, data_, size_);
+    release();
+    data_ = new_data;
+    capacity_ = new_capacity;
+}
+
+void Byte_buffer::append(Byte_const_ptr buf, size_t len)
+{
+    if (len == 0) {
+        return;
     }
+    if (size_ + len > capacity_) {
+        // buf may be part of this buffer, so it is copied before the old
+        // bytes are released
+        size_t new_capacity = std::max(size_ + len, 2 * capacity_);
+        Byte_ptr new_data = new Byte[new_capacity];
+        memcpy(new_data, data_, size_);
+        memcpy(new_data + size_, buf, len);
+        release();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    } else {
+        memmove(data_ + size_, buf, len);
+    }
+    size_ += len;
 }
 
-void Byte_buffer::initialise()
+bool Byte_buffer::operator<(Byte_buffer const &rhs) const
 {
-    byte_buf_.reserve(initial_reserved_size);
+    size_t n = std::min(size_, rhs.size_);
+    int c = (n == 0) ? 0 : memcmp(data_, rhs.data_, n);
+    return c < 0 || (c == 0 && size_ < rhs.size_);
 }
 
-Byte_buffer &Byte_buffer::operator+=(Byte_buffer const &b)
+void Byte_buffer::resize(size_t n)
 {
-    size_t len = b.size();
-    for (size_t i = 0; i < len; ++i) {
-        byte_buf_.push_back(b[i]);
+    if (n > size_) {
+        reserve(n);
+        memset(data_ + size_, 0, n - size_);
+    }
+    size_ = n;
+}
+
+void Byte_buffer::reserve(size_t n)
+{
+    if (n > capacity_) {
+        Byte_ptr new_data = new Byte[n];
+        memcpy(new_data, data_, size_);
+        release();
+        data_ = new_data;
+        capacity_ = n;
     }
-    return *this;
 }
 
 void Byte_buffer::pad_right(size_t new_length, Byte b)
 {
-    if (new_length < byte_buf_.size()) {
+    if (new_length < size_) {
         throw std::runtime_error("Byte_buffer.pad_right: already longer than this");
     }
-    size_t length_delta = new_length - byte_buf_.size();
-    for (size_t i = 0; i < length_delta; ++i) {
-        byte_buf_.push_back(b);
-    }
+    size_t current_size = size_;
+    resize(new_length);
+    memset(data_ + current_size, b, new_length - current_size);
 }
 
 void Byte_buffer::pad_left(size_t new_length, Byte b)
 {
-    size_t current_size = byte_buf_.size();
+    size_t current_size = size_;
     if (new_length < current_size) {
         throw std::runtime_error("Byte_buffer.pad_right: already longer than this");
     }
     size_t length_delta = new_length - current_size;
-    Bytes tmp(new_length, b);
-    memcpy(&tmp[length_delta], &byte_buf_[0], current_size);
-    byte_buf_ = std::move(tmp);
+    resize(new_length);
+    memmove(data_ + length_delta, data_, current_size);
+    memset(data_, b, length_delta);
 }
 
 
 void Byte_buffer::truncate()
 {
-    while (!byte_buf_.empty() && byte_buf_.back() == 0) {
-        byte_buf_.pop_back();
+    while (size_ != 0 && data_[size_ - 1] == 0) {
+        --size_;
     }
 }
 
 std::string Byte_buffer::to_hex_string() const
 {
-    std::ostringstream os;
-    size_t str_length = byte_buf_.size();
-    if (str_length == 0) {
-        return os.str();
+    static const char hex_digits[] = "0123456789abcdef";
+    std::string str(2 * size_, '0');
+    for (size_t i = 0; i < size_; ++i) {
+        str[2 * i] = hex_digits[data_[i] >> 4];
+        str[2 * i + 1] = hex_digits[data_[i] & 0x0f];
     }
-
-    os << std::setfill('0') << std::hex;
-    for (size_t i = 0; i < str_length; ++i) {
-        os << std::setw(2) << 0 + byte_buf_[i];// 0 + used to force conversion to an integer for printing
-          // otherwise this will print as a character
-    }
-    return os.str();
+    return str;
 }
 
 Byte_buffer operator+(Byte_buffer const &a, Byte_buffer const &b)
 {
-    Byte_buffer oc(a);
-    return oc += b;
+    Byte_buffer oc;
+    oc.reserve(a.size() + b.size());
+    oc += a;
+    oc += b;
+    return oc;
+}
+
+Byte_buffer operator+(Byte_buffer &&a, Byte_buffer const &b)
+{
+    a += b;
+    return std::move(a);
 }
 
 std::string bb_to_string(Byte_buffer const &bb)
 {
     size_t sz = bb.size();
-    std::string ochar(sz, '\0');
-    memcpy(&ochar[0], &bb[0], sz);
-
-    return ochar;
+    return std::string(reinterpret_cast<char const *>(bb.cdata()), sz);
 }
 
 Byte_buffer uint32_to_bb(uint32_t const ui)
@@ -218,10 +332,10 @@ Byte_buffer serialise_bb(Byte_buffer const &bb)
     if (sz > std::numeric_limits<uint16_t>::max()) {
         throw(std::runtime_error("serialise_bb: buffer to big to serialise"));
     }
-    sbb.resize(sz + 2);
-    sbb[0] = static_cast<uint8_t>(sz/byte_base);
-    sbb[1] = static_cast<uint8_t>(sz%byte_base);
-    memcpy(&sbb[2], &bb[0], sz);
+    sbb.reserve(sz + 2);
+    sbb.push_back(static_cast<uint8_t>(sz/byte_base));
+    sbb.push_back(static_cast<uint8_t>(sz%byte_base));
+    sbb += bb;
 
     return sbb;
 }
@@ -234,8 +348,7 @@ Byte_buffer deserialise_bb(Byte_buffer const &bb)
     if (sz > std::numeric_limits<uint16_t>::max() || bb.size() != sz + 2) {
         throw(std::runtime_error("deserialise_bb: inconsistent buffer size"));
     }
-    dbb.resize(sz);
-    memcpy(&dbb[0], &bb[2], sz);
+    dbb.append(bb.cdata() + 2, sz);
 
     return dbb;
 }
@@ -286,27 +399,26 @@ std::vector<Byte_buffer> deserialise_byte_buffers(Byte_buffer const &bb)
 std::istream &operator>>(std::istream &is, Byte_buffer &bb)
 {
     char c;
-    std::string hstr(2, '\0');
-    Byte b;
-    bb.byte_buf_.clear();
+    int high = -1;
+    bb.clear();
 
-    uint8_t i = 0;
     is >> std::ws;// Skip whitespace
     while (is.get(c)) {
-        if (std::isspace(c)!=0) {
+        if (std::isspace(static_cast<unsigned char>(c))!=0) {
             break;
         }
-        hstr[i++]=static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-        if (i == 2) {
-            if (std::string::npos != hstr.find_first_not_of("0123456789ABCDEFabcdef")) {
-                throw(std::runtime_error("Byte_buffer::operator>>: bad character in input stream"));
-            }
-            b = static_cast<Byte>(stoul(hstr, nullptr, 16));
-            bb.byte_buf_.push_back(b);
-            i = 0;
+        int nibble = hex_value(c);
+        if (nibble < 0) {
+            throw(std::runtime_error("Byte_buffer::operator>>: bad character in input stream"));
+        }
+        if (high < 0) {
+            high = nibble;
+        } else {
+            bb.push_back(static_cast<Byte>(high * hex_base + nibble));
+            high = -1;
         }
     }
-    if (i != 0) {
+    if (high >= 0) {
         throw(std::runtime_error("Byte_buffer::operator>>: odd nuber of characters in input stream"));
     }
 
@@ -0,0 +1,387 @@
+/*******************************************************************************
+* File:        G1_ecp.cpp
+* Description: A point in G1 held in AMCL's internal form for calculations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Amcl_utils.h"
+#include "bnp256_param.h"
+#include "G1_ecp.h"
+
+using namespace FP256BN;
+using namespace FP256BN_BIG;
+
+namespace
+{
+// Remove leading zeros to match the output from BN_bn2bin
+Byte_buffer strip_leading_zeros(Byte_buffer const& bb)
+{
+	size_t start=0;
+	while (start<bb.size() && bb[start]==0)
+	{
+		++start;
+	}
+	return bb.get_part(start,bb.size()-start);
+}
+
+// Odd multiples P,3P,...,(2^(w-1)-1)P are precomputed for width-w NAF
+const int wnaf_width=4;
+const size_t wnaf_table_size=1<<(wnaf_width-2);
+
+struct Straus_term
+{
+	std::vector<int> digits;    // Least significant first
+	ECP table[wnaf_table_size];
+};
+
+// Recodes k (which is destroyed) so that each non-zero digit is odd, less
+// than 2^(w-1) in magnitude, and followed by at least w-1 zeros
+std::vector<int> wnaf(BIG k)
+{
+	std::vector<int> digits;
+	BIG_norm(k);
+	while (BIG_iszilch(k)==0)
+	{
+		int d=0;
+		if (BIG_parity(k)==1)
+		{
+			d=BIG_lastbits(k,wnaf_width);
+			if (d>=(1<<(wnaf_width-1)))
+			{
+				d-=(1<<wnaf_width);
+			}
+			BIG_dec(k,d);
+			BIG_norm(k);
+		}
+		digits.push_back(d);
+		BIG_fshr(k,1);
+	}
+	return digits;
+}
+
+void make_straus_term(BIG k, ECP const& pt, Straus_term& term)
+{
+	term.digits=wnaf(k);
+	ECP twice;
+	ECP_copy(&term.table[0],const_cast<ECP*>(&pt));
+	ECP_copy(&twice,const_cast<ECP*>(&pt));
+	ECP_dbl(&twice);
+	for (size_t i=1;i<wnaf_table_size;i++)
+	{
+		ECP_copy(&term.table[i],&term.table[i-1]);
+		ECP_add(&term.table[i],&twice);
+	}
+}
+}
+
+void scalar_to_big(Byte_buffer const& k, BIG& n)
+{
+	if (k.size()>amcl_component_size)
+	{
+		bb_to_big(bb_mod(k,bnp256_order),n);
+	}
+	else
+	{
+		bb_to_big(k,n);
+	}
+	BIG order;
+	BIG_rcopy(order,CURVE_Order);
+	BIG_mod(n,order);
+}
+
+// This is AMCL's glv(), which is not exported
+void glv_split(BIG e, BIG u[2])
+{
+	BIG v[2],t,q;
+	DBIG d;
+	BIG_rcopy(q,CURVE_Order);
+	for (int i=0;i<2;i++)
+	{
+		BIG_rcopy(t,CURVE_W[i]);
+		BIG_mul(d,t,e);
+		BIG_ddiv(v[i],d,q);
+		BIG_zero(u[i]);
+	}
+	BIG_copy(u[0],e);
+	for (int i=0;i<2;i++)
+	{
+		for (int j=0;j<2;j++)
+		{
+			BIG_rcopy(t,CURVE_SB[j][i]);
+			BIG_modmul(t,v[j],t,q);
+			BIG_add(u[i],u[i],q);
+			BIG_sub(u[i],u[i],t);
+			BIG_mod(u[i],q);
+		}
+	}
+}
+
+G1_ecp::G1_ecp()
+{
+	ECP_inf(&pt_);
+}
+
+G1_ecp::G1_ecp(G1_point const& pt)
+{
+	if (pt.first.size()>amcl_component_size || pt.second.size()>amcl_component_size)
+	{
+		throw(std::runtime_error("G1_ecp: coordinate too large"));
+	}
+	BIG x,y;
+	bb_to_big(pt.first,x);
+	bb_to_big(pt.second,y);
+	if (ECP_set(&pt_,x,y)==0)
+	{
+		throw(std::runtime_error("G1_ecp: point is not on the curve"));
+	}
+}
+
+G1_ecp G1_ecp::generator()
+{
+	G1_ecp g;
+	ECP_generator(&g.pt_);
+	return g;
+}
+
+// AMCL does not use const, but these functions do not change the points
+bool G1_ecp::is_infinity() const
+{
+	return (ECP_isinf(const_cast<ECP*>(&pt_))==1);
+}
+
+bool G1_ecp::operator==(G1_ecp const& rhs) const
+{
+	return (ECP_equals(const_cast<ECP*>(&pt_),const_cast<ECP*>(&rhs.pt_))==1);
+}
+
+G1_ecp& G1_ecp::operator+=(G1_ecp const& rhs)
+{
+	ECP tmp;
+	ECP_copy(&tmp,const_cast<ECP*>(&rhs.pt_));
+	ECP_add(&pt_,&tmp);
+	return *this;
+}
+
+G1_ecp& G1_ecp::operator-=(G1_ecp const& rhs)
+{
+	ECP tmp;
+	ECP_copy(&tmp,const_cast<ECP*>(&rhs.pt_));
+	ECP_sub(&pt_,&tmp);
+	return *this;
+}
+
+G1_ecp G1_ecp::operator-() const
+{
+	G1_ecp result(*this);
+	ECP_neg(&result.pt_);
+	return result;
+}
+
+G1_ecp& G1_ecp::operator*=(Byte_buffer const& k)
+{
+	BIG n;
+	scalar_to_big(k,n);
+	PAIR_G1mul(&pt_,n);
+	return *this;
+}
+
+G1_point G1_ecp::to_g1_point() const
+{
+	BIG x,y;
+	if (ECP_get(x,y,const_cast<ECP*>(&pt_))==-1)
+	{
+		throw(std::runtime_error("G1_ecp: the point at infinity has no affine coordinates"));
+	}
+	return std::make_pair(strip_leading_zeros(big_to_bb(x)),strip_leading_zeros(big_to_bb(y)));
+}
+
+G1_ecp operator+(G1_ecp a, G1_ecp const& b)
+{
+	a+=b;
+	return a;
+}
+
+G1_ecp operator-(G1_ecp a, G1_ecp const& b)
+{
+	a-=b;
+	return a;
+}
+
+G1_ecp operator*(Byte_buffer const& k, G1_ecp pt)
+{
+	pt*=k;
+	return pt;
+}
+
+void g1_batch_normalise(std::vector<G1_ecp>& pts)
+{
+	// Points at infinity and points already in affine form are skipped
+	FP one;
+	FP_one(&one);
+	std::vector<bool> skip(pts.size());
+	bool none_to_do=true;
+
+	// prefix[i] is z_0*...*z_(i-1), over the points that are not skipped
+	std::vector<FP> prefix(pts.size());
+	FP acc;
+	FP_one(&acc);
+	for (size_t i=0;i<pts.size();++i)
+	{
+		FP_copy(&prefix[i],&acc);
+		ECP* p=pts[i].ecp();
+		skip[i]=ECP_isinf(p) || FP_equals(&p->z,&one);
+		if (!skip[i])
+		{
+			FP_mul(&acc,&acc,&p->z);
+			none_to_do=false;
+		}
+	}
+	if (none_to_do)
+	{
+		return;
+	}
+
+	// inv is 1/(z_0*...*z_i) on each step back, so 1/z_i=inv*prefix[i]
+	FP inv;
+	FP_inv(&inv,&acc);
+	for (size_t i=pts.size();i-->0;)
+	{
+		if (skip[i])
+		{
+			continue;
+		}
+		ECP* p=pts[i].ecp();
+		FP iz;
+		FP_mul(&iz,&inv,&prefix[i]);
+		FP_mul(&inv,&inv,&p->z);
+		FP_mul(&p->x,&p->x,&iz);
+		FP_reduce(&p->x);
+		FP_mul(&p->y,&p->y,&iz);
+		FP_reduce(&p->y);
+		FP_one(&p->z);
+	}
+}
+
+std::vector<G1_point> g1_batch_to_g1_points(std::vector<G1_ecp> pts)
+{
+	g1_batch_normalise(pts);
+	std::vector<G1_point> result;
+	result.reserve(pts.size());
+	for (auto const& pt : pts)
+	{
+		result.push_back(pt.to_g1_point());
+	}
+	return result;
+}
+
+G1_ecp ec_multi_mul(std::vector<Byte_buffer> const& scalars, std::vector<G1_ecp> const& points)
+{
+	if (scalars.size()!=points.size())
+	{
+		throw(std::runtime_error("ec_multi_mul: the number of scalars and points differ"));
+	}
+
+	BIG q;
+	BIG_rcopy(q,CURVE_Order);
+	FP cru;
+	FP_rcopy(&cru,CURVE_Cru);
+
+	// [k]P=[u_0]P+[u_1]phi(P), phi(x,y)=(cru.x,y). As in PAIR_G1mul, use -u
+	// and -P when -u mod q is shorter.
+	std::vector<Straus_term> terms(2*scalars.size());
+	for (size_t i=0;i<scalars.size();i++)
+	{
+		BIG e;
+		BIG u[2];
+		scalar_to_big(scalars[i],e);
+		glv_split(e,u);
+
+		ECP pt[2];
+		ECP_copy(&pt[0],const_cast<ECP*>(points[i].ecp()));
+		ECP_affine(&pt[0]);
+		ECP_copy(&pt[1],&pt[0]);
+		FP_mul(&(pt[1].x),&(pt[1].x),&cru);
+
+		for (int j=0;j<2;j++)
+		{
+			BIG t;
+			BIG_modneg(t,u[j],q);
+			if (BIG_nbits(t)<BIG_nbits(u[j]))
+			{
+				BIG_copy(u[j],t);
+				ECP_neg(&pt[j]);
+			}
+			BIG_norm(u[j]);
+			make_straus_term(u[j],pt[j],terms[2*i+j]);
+		}
+	}
+
+	size_t length=0;
+	for (auto const& t : terms)
+	{
+		length=std::max(length,t.digits.size());
+	}
+
+	G1_ecp result;
+	for (size_t i=length;i-->0;)
+	{
+		ECP_dbl(result.ecp());
+		for (auto& t : terms)
+		{
+			if (i>=t.digits.size() || t.digits[i]==0)
+			{
+				continue;
+			}
+			int d=t.digits[i];
+			if (d>0)
+			{
+				ECP_add(result.ecp(),&t.table[d/2]);
+			}
+			else
+			{
+				ECP_sub(result.ecp(),&t.table[(-d)/2]);
+			}
+		}
+	}
+	return result;
+}
@@ -0,0 +1,260 @@
+/*******************************************************************************
+* File:        G1_fixed_base.cpp
+* Description: Multiplication of fixed points in G1 using precomputed tables
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include <stdexcept>
+#include "Byte_buffer.h"
+#include "Amcl_utils.h"
+#include "G1_ecp.h"
+#include "G1_fixed_base.h"
+
+using namespace FP256BN;
+using namespace FP256BN_BIG;
+
+namespace
+{
+// A scalar mod the order, once made odd, is 64 signed digits and a final 1
+const size_t fixed_base_rows=65;
+
+// The GLV parts of a scalar are under 2^130, so 33 signed digits and a final
+// one cover them, whatever the scalar
+const size_t glv_digits=33;
+
+// Conditional move of q to p, if d is 1. AMCL's ECP_cmove is not exported.
+void ecp_cmove(ECP& p, ECP const& q, int d)
+{
+	FP_cmove(&p.x,const_cast<FP*>(&q.x),d);
+	FP_cmove(&p.y,const_cast<FP*>(&q.y),d);
+	FP_cmove(&p.z,const_cast<FP*>(&q.z),d);
+}
+
+int ct_equal(int a, int b)
+{
+	return static_cast<int>((static_cast<unsigned>(a^b)-1)>>31);
+}
+
+// Sets r to [d]P, where row holds P,3P,...,15P and d is odd, without the
+// memory accesses depending on d
+void select_multiple(ECP& r, ECP const* row, int d)
+{
+	int m=d>>(8*sizeof(int)-1);
+	int index=(((d^m)-m)-1)/2;
+	ECP_copy(&r,const_cast<ECP*>(&row[0]));
+	for (int j=1;j<static_cast<int>(g1_odd_multiples);j++)
+	{
+		ecp_cmove(r,row[j],ct_equal(j,index));
+	}
+	ECP neg;
+	ECP_copy(&neg,&r);
+	ECP_neg(&neg);
+	ecp_cmove(r,neg,m&1);
+}
+
+void make_odd_multiples(ECP const& pt, ECP* row)
+{
+	ECP twice;
+	ECP_copy(&twice,const_cast<ECP*>(&pt));
+	ECP_dbl(&twice);
+	ECP_copy(&row[0],const_cast<ECP*>(&pt));
+	for (size_t j=1;j<g1_odd_multiples;j++)
+	{
+		ECP_copy(&row[j],&row[j-1]);
+		ECP_add(&row[j],&twice);
+	}
+}
+
+// Makes e odd by adding 1 if it is even, or 2 if it is odd. Returns 1 in
+// the second case. The multiple of the base to take off at the end is then
+// the return value plus 1.
+int make_odd(BIG e)
+{
+	BIG t;
+	int s=BIG_parity(e);
+	BIG_inc(e,1);
+	BIG_norm(e);
+	BIG_copy(t,e);
+	BIG_inc(t,1);
+	BIG_norm(t);
+	BIG_cmove(e,t,s);
+	return s;
+}
+
+// Recodes the odd number t (which is destroyed) as n odd digits in [-15,15]
+// and a final positive digit, least significant first
+void regular_recode(BIG t, size_t n, std::vector<int>& digits)
+{
+	digits.resize(n+1);
+	for (size_t i=0;i<n;i++)
+	{
+		int d=BIG_lastbits(t,5)-16;
+		BIG_dec(t,d);
+		BIG_norm(t);
+		BIG_fshr(t,4);
+		digits[i]=d;
+	}
+	digits[n]=BIG_lastbits(t,5);
+}
+
+// [1]P or [2]P, as make_odd returned 0 or 1
+void correction(ECP& c, ECP const& pt, ECP const& twice_pt, int s)
+{
+	ECP_copy(&c,const_cast<ECP*>(&pt));
+	ecp_cmove(c,twice_pt,s);
+}
+}
+
+G1_fixed_base::G1_fixed_base(G1_ecp const& base) : table_(fixed_base_rows*g1_odd_multiples)
+{
+	ECP_copy(&base_,const_cast<ECP*>(base.ecp()));
+	ECP_copy(&twice_base_,&base_);
+	ECP_dbl(&twice_base_);
+
+	ECP row_base;
+	ECP_copy(&row_base,&base_);
+	for (size_t i=0;i<fixed_base_rows;i++)
+	{
+		make_odd_multiples(row_base,&table_[i*g1_odd_multiples]);
+		for (int j=0;j<4;j++)
+		{
+			ECP_dbl(&row_base);
+		}
+	}
+}
+
+G1_ecp G1_fixed_base::mul(Byte_buffer const& k) const
+{
+	BIG e;
+	scalar_to_big(k,e);
+	int s=make_odd(e);
+	std::vector<int> digits;
+	regular_recode(e,fixed_base_rows-1,digits);
+
+	G1_ecp result;
+	ECP tmp;
+	for (size_t i=0;i<fixed_base_rows;i++)
+	{
+		select_multiple(tmp,&table_[i*g1_odd_multiples],digits[i]);
+		ECP_add(result.ecp(),&tmp);
+	}
+	correction(tmp,base_,twice_base_,s);
+	ECP_sub(result.ecp(),&tmp);
+	return result;
+}
+
+G1_fixed_base const& g1_generator_table()
+{
+	// Initialisation of a local static is thread safe
+	static G1_fixed_base const table(G1_ecp::generator());
+	return table;
+}
+
+G1_prepared_point::G1_prepared_point(G1_ecp const& pt)
+{
+	make_odd_multiples(*pt.ecp(),table_[0]);
+	FP cru;
+	FP_rcopy(&cru,CURVE_Cru);
+	for (size_t j=0;j<g1_odd_multiples;j++)
+	{
+		ECP_copy(&table_[1][j],&table_[0][j]);
+		FP_mul(&(table_[1][j].x),&(table_[1][j].x),&cru);
+	}
+}
+
+G1_ecp G1_prepared_point::mul(Byte_buffer const& k) const
+{
+	BIG e,q,t,d;
+	BIG u[2];
+	scalar_to_big(k,e);
+	glv_split(e,u);
+	BIG_rcopy(q,CURVE_Order);
+
+	// As in PAIR_G1mul, use -u with -P, if -u mod q is smaller. The choice
+	// is made from the sign of (q-u)-u, rather than the bit lengths.
+	int neg[2];
+	int s[2];
+	for (int j=0;j<2;j++)
+	{
+		BIG_sub(t,q,u[j]);
+		BIG_norm(t);
+		BIG_sub(d,t,u[j]);
+		BIG_norm(d);
+		neg[j]=static_cast<int>((d[NLEN_B256_56-1]>>(8*sizeof(chunk)-1))&1);
+		BIG_cmove(u[j],t,neg[j]);
+		s[j]=make_odd(u[j]);
+	}
+
+	std::vector<int> digits[2];
+	for (int j=0;j<2;j++)
+	{
+		regular_recode(u[j],glv_digits,digits[j]);
+	}
+
+	G1_ecp result;
+	ECP tmp;
+	for (size_t i=glv_digits+1;i-->0;)
+	{
+		if (i<glv_digits)
+		{
+			for (int b=0;b<4;b++)
+			{
+				ECP_dbl(result.ecp());
+			}
+		}
+		for (int j=0;j<2;j++)
+		{
+			int m=-neg[j];
+			select_multiple(tmp,table_[j],(digits[j][i]^m)-m);
+			ECP_add(result.ecp(),&tmp);
+		}
+	}
+	for (int j=0;j<2;j++)
+	{
+		ECP twice;
+		ECP_copy(&twice,const_cast<ECP*>(&table_[j][0]));
+		ECP_dbl(&twice);
+		correction(tmp,table_[j][0],twice,s[j]);
+		ECP minus;
+		ECP_copy(&minus,&tmp);
+		ECP_neg(&minus);
+		ecp_cmove(tmp,minus,neg[j]);
+		ECP_sub(result.ecp(),&tmp);
+	}
+	return result;
+}
@@ -44,18 +44,34 @@
 #include "G1_utils.h"
 
 
+namespace
+{
+// Appends a coordinate padded on the left with zeros
+void append_coord(Byte_buffer& bb, Byte_buffer const& coord)
+{
+    if (coord.size()>g1_coord_size)
+    {
+        throw(std::runtime_error("g1_point_concat: coordinate too long"));
+    }
+    bb.resize(bb.size()+g1_coord_size-coord.size());
+    bb+=coord;
+}
+}
+
 Byte_buffer g1_point_concat(G1_point const& pt)
 {
-    G1_point tmp=pt;
-	tmp.first.pad_left(g1_coord_size);
-    tmp.second.pad_left(g1_coord_size);
-    return tmp.first+tmp.second;
+    Byte_buffer bb;
+    append_coord(bb,pt.first);
+    append_coord(bb,pt.second);
+    return bb;
 }
 
 Byte_buffer g1_point_uncompressed(G1_point const& pt)
 {
-	Byte_buffer prefix{0x04};
-	return prefix+g1_point_concat(pt);
+	Byte_buffer bb{0x04};
+    append_coord(bb,pt.first);
+    append_coord(bb,pt.second);
+	return bb;
 }
 
 G1_point g1_point_from_bb(Byte_buffer const& bb)
@@ -64,8 +80,8 @@ G1_point g1_point_from_bb(Byte_buffer const& bb)
     {
         throw(std::runtime_error("g1_point_from_bb: must use padded coordinates"));
     }
-	return std::make_pair(bb.get_part(0,g1_coord_size),
-						  bb.get_part(g1_coord_size,g1_coord_size));
+	return std::make_pair(Byte_buffer(bb.view(0,g1_coord_size)),
+						  Byte_buffer(bb.view(g1_coord_size,g1_coord_size)));
 }
 
 G1_point g1_point_from_uncompressed(Byte_buffer const& bb)
@@ -79,8 +95,8 @@ G1_point g1_point_from_uncompressed(Byte_buffer const& bb)
         throw(std::runtime_error("g1_point_from_uncompressed: first byte should be 0x04"));
     }
 
-	return std::make_pair(bb.get_part(0,g1_coord_size),
-						  bb.get_part(g1_coord_size,g1_coord_size));
+	return std::make_pair(Byte_buffer(bb.view(1,g1_coord_size)),
+						  Byte_buffer(bb.view(1+g1_coord_size,g1_coord_size)));
 }
 
 Byte_buffer g1_point_serialise(G1_point const& pt)
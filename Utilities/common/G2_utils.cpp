@@ -45,6 +45,15 @@
 #include "Tpm_error.h"
 #include "G2_utils.h"
 
+namespace
+{
+G2_coord g2_coord_from_view(Byte_view bv)
+{
+	return std::make_pair(Byte_buffer(bv.subview(0,g2_coord_component_size)),
+				Byte_buffer(bv.subview(g2_coord_component_size,g2_coord_component_size)));
+}
+}
+
 Byte_buffer g2_coord_concat(G2_coord const& coord)
 {
 	return coord.first+coord.second;
@@ -52,19 +61,24 @@ Byte_buffer g2_coord_concat(G2_coord const& coord)
 
 G2_coord g2_coord_from_bb(Byte_buffer const& bb)
 {
-	return std::make_pair(bb.get_part(0,g2_coord_component_size),
-				bb.get_part(g2_coord_component_size,g2_coord_component_size));
+	return g2_coord_from_view(bb.view(0,bb.size()));
 }
 
 Byte_buffer g2_point_concat(G2_point const& pt)
 {
-	return g2_coord_concat(pt.first)+g2_coord_concat(pt.second);
+	Byte_buffer bb;
+	bb.reserve(g2_affine_point_size);
+	bb+=pt.first.first;
+	bb+=pt.first.second;
+	bb+=pt.second.first;
+	bb+=pt.second.second;
+	return bb;
 }
 
 G2_point g2_point_from_bb(Byte_buffer const& bb)
 {
-	return std::make_pair(g2_coord_from_bb(bb.get_part(0,g2_coord_size)),
-				g2_coord_from_bb(bb.get_part(g2_coord_size,g2_coord_size)));
+	return std::make_pair(g2_coord_from_view(bb.view(0,g2_coord_size)),
+				g2_coord_from_view(bb.view(g2_coord_size,g2_coord_size)));
 }
 
 Byte_buffer g2_coord_serialise(G2_coord const& coord)
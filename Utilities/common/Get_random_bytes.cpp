@@ -38,45 +38,237 @@
 *                                                                              *
 *******************************************************************************/
 
-#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
 #include "Get_random_bytes.h"
 
-Random_byte_generator::Random_byte_generator(unsigned int seed)
+namespace
 {
-	unsigned int clock_seed = std::chrono::system_clock::now().time_since_epoch().count();
-	unsigned int s=seed?seed:clock_seed;
-	dre.seed(s);
-	rb=std::uniform_int_distribution<short>(0,0xff);
+// Counts the forks, so that a generator can tell that it has been copied into
+// a child process and must not repeat the parent's output
+std::atomic<unsigned int> forks(0);
+
+void count_fork()
+{
+	forks.fetch_add(1,std::memory_order_relaxed);
 }
 
-Byte_buffer Random_byte_generator::operator()(size_t number_of_bytes)
+unsigned int forks_so_far()
 {
-	Byte_buffer r_bytes(number_of_bytes,0);
-	for (int i=0;i<number_of_bytes;++i)
+	static std::once_flag registered;
+	std::call_once(registered,[]{pthread_atfork(nullptr,nullptr,count_fork);});
+	return forks.load(std::memory_order_relaxed);
+}
+
+inline uint32_t rotl(uint32_t x, int n)
+{
+	return (x<<n)|(x>>(32-n));
+}
+
+inline void quarter_round(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d)
+{
+	a+=b;
+	d=rotl(d^a,16);
+	c+=d;
+	b=rotl(b^c,12);
+	a+=b;
+	d=rotl(d^a,8);
+	c+=d;
+	b=rotl(b^c,7);
+}
+
+// One 64 byte block of the ChaCha20 key stream (RFC 8439), with a zero nonce
+void chacha20_block(uint32_t const* key, uint32_t counter, Byte_ptr out)
+{
+	uint32_t const in[16]={
+		0x61707865,0x3320646e,0x79622d32,0x6b206574,
+		key[0],key[1],key[2],key[3],key[4],key[5],key[6],key[7],
+		counter,0,0,0
+	};
+	uint32_t x[16];
+	std::memcpy(x,in,sizeof(x));
+	for (int i=0;i<10;++i)
+	{
+		quarter_round(x[0],x[4],x[8],x[12]);
+		quarter_round(x[1],x[5],x[9],x[13]);
+		quarter_round(x[2],x[6],x[10],x[14]);
+		quarter_round(x[3],x[7],x[11],x[15]);
+		quarter_round(x[0],x[5],x[10],x[15]);
+		quarter_round(x[1],x[6],x[11],x[12]);
+		quarter_round(x[2],x[7],x[8],x[13]);
+		quarter_round(x[3],x[4],x[9],x[14]);
+	}
+	for (size_t i=0;i<16;++i)
+	{
+		uint32_t v=x[i]+in[i];
+		out[4*i]=static_cast<Byte>(v);
+		out[4*i+1]=static_cast<Byte>(v>>8);
+		out[4*i+2]=static_cast<Byte>(v>>16);
+		out[4*i+3]=static_cast<Byte>(v>>24);
+	}
+}
+
+// Writes through a volatile pointer, so that it is not optimised away
+void erase(void* p, size_t len)
+{
+	volatile Byte* vp=static_cast<volatile Byte*>(p);
+	while (len--)
+	{
+		*vp++=0;
+	}
+}
+
+void read_urandom(Byte_ptr out, size_t len)
+{
+	int fd=open("/dev/urandom",O_RDONLY|O_CLOEXEC);
+	if (fd<0)
+	{
+		throw(std::runtime_error("get_system_random_bytes: unable to open /dev/urandom"));
+	}
+	while (len>0)
 	{
-		r_bytes[i]=static_cast<Byte>(rb(dre));
+		ssize_t n=read(fd,out,len);
+		if (n<=0)
+		{
+			if (n<0 && errno==EINTR)
+			{
+				continue;
+			}
+			close(fd);
+			throw(std::runtime_error("get_system_random_bytes: unable to read /dev/urandom"));
+		}
+		out+=n;
+		len-=n;
 	}
+	close(fd);
+}
+}
 
+void get_system_random_bytes(Byte_ptr out, size_t len)
+{
+#ifdef SYS_getrandom
+	while (len>0)
+	{
+		long n=syscall(SYS_getrandom,out,len,0);
+		if (n<0)
+		{
+			if (errno==EINTR)
+			{
+				continue;
+			}
+			if (errno==ENOSYS)
+			{
+				// A kernel older than 3.17
+				read_urandom(out,len);
+				return;
+			}
+			throw(std::runtime_error("get_system_random_bytes: getrandom failed"));
+		}
+		out+=n;
+		len-=n;
+	}
+#else
+	read_urandom(out,len);
+#endif
+}
+
+Random_byte_generator::Random_byte_generator(uint64_t seed) :
+used_(sizeof(buffer_)), fixed_seed_(seed!=0), forks_seen_(0)
+{
+	if (fixed_seed_)
+	{
+		std::fill(key_,key_+key_words,0);
+		key_[0]=static_cast<uint32_t>(seed);
+		key_[1]=static_cast<uint32_t>(seed>>32);
+	}
+	else
+	{
+		reseed();
+	}
+}
+
+Random_byte_generator::~Random_byte_generator()
+{
+	erase(key_,sizeof(key_));
+	erase(buffer_,sizeof(buffer_));
+}
+
+void Random_byte_generator::reseed()
+{
+	forks_seen_=forks_so_far();
+	Byte seed[key_words*4];
+	get_system_random_bytes(seed,sizeof(seed));
+	for (size_t i=0;i<key_words;++i)
+	{
+		key_[i]=uint32_t(seed[4*i])|(uint32_t(seed[4*i+1])<<8)|(uint32_t(seed[4*i+2])<<16)|(uint32_t(seed[4*i+3])<<24);
+	}
+	erase(seed,sizeof(seed));
+	erase(buffer_,sizeof(buffer_));
+	used_=sizeof(buffer_);
+}
+
+void Random_byte_generator::refill()
+{
+	for (size_t b=0;b<buffer_blocks;++b)
+	{
+		chacha20_block(key_,static_cast<uint32_t>(b),buffer_+b*block_size);
+	}
+	// The first 32 bytes are the next key, and are not given out
+	for (size_t i=0;i<key_words;++i)
+	{
+		key_[i]=uint32_t(buffer_[4*i])|(uint32_t(buffer_[4*i+1])<<8)|(uint32_t(buffer_[4*i+2])<<16)|(uint32_t(buffer_[4*i+3])<<24);
+	}
+	std::memset(buffer_,0,sizeof(key_));
+	used_=sizeof(key_);
+}
+
+void Random_byte_generator::fill(Byte_ptr out, size_t len)
+{
+	if (!fixed_seed_ && forks_seen_!=forks_so_far())
+	{
+		reseed();
+	}
+	while (len>0)
+	{
+		if (used_==sizeof(buffer_))
+		{
+			refill();
+		}
+		size_t n=std::min(len,sizeof(buffer_)-used_);
+		std::memcpy(out,buffer_+used_,n);
+		std::memset(buffer_+used_,0,n);
+		used_+=n;
+		out+=n;
+		len-=n;
+	}
+}
+
+Byte_buffer Random_byte_generator::operator()(size_t number_of_bytes)
+{
+	Byte_buffer r_bytes(number_of_bytes,0);
+	fill(r_bytes.data(),number_of_bytes);
 	return r_bytes;
 }
 
+Random_byte_generator& thread_random_generator()
+{
+	thread_local Random_byte_generator rbg;
+	return rbg;
+}
 
 Byte_buffer get_random_bytes(
 size_t number_of_bytes,
 unsigned int seed
 )
 {
-	// Use the C++ PRNG for now
-	std::default_random_engine dre(seed);
-	std::uniform_int_distribution<short> rb(0, 0xFF);
-
-	Byte_buffer result(number_of_bytes, 0); 
-
-	result[0]=static_cast<Byte>(rb(dre));	// Discard the first value ?? 
-                                        // Yes if seeding from time(NULL), see:
-                                        // https://stackoverflow.com/questions/26475595
-	for (int i = 0; i < number_of_bytes; ++i)
-		result[i] =static_cast<Byte>(rb(dre));
-
-	return result;
+	Random_byte_generator rbg(seed);
+	return rbg(number_of_bytes);
 }
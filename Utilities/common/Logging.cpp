@@ -40,11 +40,105 @@
 
 #include <iosfwd>
 #include <sstream>
+#include <cstdio>
 #include "Clock_utils.h"
 #include "Logging.h"
 
 Log_ptr log_ptr=Log_ptr(new Null_log);
 
+void Log::write_record(Log_record const& record)
+{
+	write_to_log(format_log_record(record));
+}
+
+void make_text_record(Log_record& r, char const* text, size_t size)
+{
+	r=Log_record();
+	r.time=std::chrono::system_clock::now().time_since_epoch().count();
+	r.append_data(text,size);
+}
+
+namespace
+{
+void append_log_value(std::string& str, Log_record const& r, size_t i)
+{
+	Log_record::Arg_value const& v=r.values[i];
+	char number[32];
+	switch (r.types[i])
+	{
+	case Log_record::Arg_type::signed_int:
+		str.append(number,std::snprintf(number,sizeof(number),"%lld",static_cast<long long>(v.i)));
+		break;
+	case Log_record::Arg_type::unsigned_int:
+		str.append(number,std::snprintf(number,sizeof(number),"%llu",static_cast<unsigned long long>(v.u)));
+		break;
+	case Log_record::Arg_type::floating:
+		str.append(number,std::snprintf(number,sizeof(number),"%g",v.d));
+		break;
+	case Log_record::Arg_type::text:
+		str.append(r.data+v.span.offset,v.span.size);
+		break;
+	case Log_record::Arg_type::bytes:
+		{
+			static const char hex_digits[]="0123456789abcdef";
+			for (size_t j=0;j<v.span.size;++j)
+			{
+				uint8_t b=static_cast<uint8_t>(r.data[v.span.offset+j]);
+				str+=hex_digits[b>>4];
+				str+=hex_digits[b&0x0f];
+			}
+		}
+		break;
+	}
+}
+}
+
+std::string format_log_record(Log_record const& r)
+{
+	std::string str;
+	append_log_record(str,r);
+	return str;
+}
+
+void append_log_record(std::string& str, Log_record const& r)
+{
+	size_t start=str.size();
+	if (r.format==nullptr)
+	{
+		str.append(r.data,r.data_used);
+	}
+	else
+	{
+		size_t arg=0;
+		for (char const* f=r.format;*f!='\0';++f)
+		{
+			if (f[0]=='{' && f[1]=='}' && arg<r.n_args)
+			{
+				append_log_value(str,r,arg++);
+				++f;
+			}
+			else
+			{
+				str+=*f;
+			}
+		}
+	}
+	if (r.truncated)
+	{
+		str+="...";
+	}
+	if (str.size()==start || str.back()!='\n')
+	{
+		str+='\n';
+	}
+}
+
+std::string log_record_time(Log_record const& r)
+{
+	std::chrono::system_clock::time_point tp{std::chrono::system_clock::duration(r.time)};
+	return time_point_to_string(tp);
+}
+
 std::ostream& Timed_cout_log::os()
 {
 	auto tp = std::chrono::system_clock::now();
@@ -44,10 +44,7 @@
 
 Byte_buffer initialise_random_iv(size_t size)
 {
-    unsigned int seed = 1+time(NULL);
-    Byte_buffer rand_iv=get_random_bytes(size,seed);
-
-    return rand_iv;
+    return thread_random_generator()(size);
 }
 
 AES_KEY get_aes_key(Byte_buffer const& aes_bb)
@@ -51,9 +51,19 @@ Bn_ptr new_bn()
     return Bn_ptr(BN_new(), ::BN_free);
 }
 
+BN_CTX* thread_bn_ctx()
+{
+    thread_local Bn_ctx_ptr ctx(BN_CTX_new(), ::BN_CTX_free);
+    if (ctx==nullptr)
+    {
+        throw(Openssl_error("thread_bn_ctx: failed to allocate the BN_CTX"));
+    }
+    return ctx.get();
+}
+
 Byte_buffer bb_mod(Byte_buffer const& num,Byte_buffer const& modulus)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr mod_bn=new_bn();
     BN_bin2bn(&modulus[0],modulus.size(),mod_bn.get());
 
@@ -62,7 +72,7 @@ Byte_buffer bb_mod(Byte_buffer const& num,Byte_buffer const& modulus)
 
 	Byte_buffer result;
 	Bn_ptr rem_bn=new_bn();
-    if (1!=BN_nnmod(rem_bn.get(),n_bn.get(),mod_bn.get(),ctx.get()))
+    if (1!=BN_nnmod(rem_bn.get(),n_bn.get(),mod_bn.get(),ctx))
     {
         throw(Openssl_error("Mod calculation failed"));;
     }
@@ -90,7 +100,7 @@ Byte_buffer bb_add(Byte_buffer const& a,Byte_buffer const& b)
 
 Byte_buffer bb_mod_add(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer const& n)
 {
-    Bn_ctx_ptr ctx=new_bn_ctx();
+    BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr a_bn=new_bn();
     BN_bin2bn(&a[0],a.size(),a_bn.get());
 
@@ -102,7 +112,7 @@ Byte_buffer bb_mod_add(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer con
 
 	Byte_buffer result;
 	Bn_ptr res_bn=new_bn();
-    if (1!=BN_mod_add(res_bn.get(),a_bn.get(),b_bn.get(),n_bn.get(),ctx.get()))
+    if (1!=BN_mod_add(res_bn.get(),a_bn.get(),b_bn.get(),n_bn.get(),ctx))
     {
         throw(Openssl_error("Modular_addition failed"));
     }
@@ -130,7 +140,7 @@ Byte_buffer bb_sub(Byte_buffer const& a,Byte_buffer const& b)
 
 Byte_buffer bb_mod_sub(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer const& n)
 {
-    Bn_ctx_ptr ctx=new_bn_ctx();
+    BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr a_bn=new_bn();
     BN_bin2bn(&a[0],a.size(),a_bn.get());
 
@@ -142,7 +152,7 @@ Byte_buffer bb_mod_sub(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer con
 
 	Byte_buffer result;
 	Bn_ptr res_bn=new_bn();
-    if (1!=BN_mod_sub(res_bn.get(),a_bn.get(),b_bn.get(),n_bn.get(),ctx.get()))
+    if (1!=BN_mod_sub(res_bn.get(),a_bn.get(),b_bn.get(),n_bn.get(),ctx))
     {
         throw(Openssl_error("Modular_addition failed"));
     }
@@ -152,7 +162,7 @@ Byte_buffer bb_mod_sub(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer con
 
 Byte_buffer bb_mul(Byte_buffer const& a,Byte_buffer const& b)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr a_bn=new_bn();
     BN_bin2bn(&a[0],a.size(),a_bn.get());
 
@@ -161,7 +171,7 @@ Byte_buffer bb_mul(Byte_buffer const& a,Byte_buffer const& b)
 
 	Byte_buffer result;
 	Bn_ptr res_bn=new_bn();
-    if (1!=BN_mul(res_bn.get(),a_bn.get(),b_bn.get(),ctx.get()))
+    if (1!=BN_mul(res_bn.get(),a_bn.get(),b_bn.get(),ctx))
     {
         throw(Openssl_error("Multiplication failed"));
     }
@@ -171,7 +181,7 @@ Byte_buffer bb_mul(Byte_buffer const& a,Byte_buffer const& b)
 
 Byte_buffer bb_mod_mul(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer const& n)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr a_bn=new_bn();
     BN_bin2bn(&a[0],a.size(),a_bn.get());
 
@@ -183,7 +193,7 @@ Byte_buffer bb_mod_mul(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer con
 
 	Byte_buffer result;
 	Bn_ptr res_bn=new_bn();
-    if (1!=BN_mod_mul(res_bn.get(),a_bn.get(),b_bn.get(),n_bn.get(),ctx.get()))
+    if (1!=BN_mod_mul(res_bn.get(),a_bn.get(),b_bn.get(),n_bn.get(),ctx))
     {
         throw(Openssl_error("Modular multiplication failed"));
     }
@@ -193,7 +203,7 @@ Byte_buffer bb_mod_mul(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer con
 
 Byte_buffer bb_signature_calc(Byte_buffer const& a,Byte_buffer const& b,Byte_buffer const&c,Byte_buffer const& modulus)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr bn_n=new_bn();
     BN_bin2bn(&modulus[0],modulus.size(),bn_n.get());
 
@@ -207,12 +217,12 @@ Byte_buffer bb_signature_calc(Byte_buffer const& a,Byte_buffer const& b,Byte_buf
     BN_bin2bn(&c[0],c.size(),bn_tmp.get());
 
 	Byte_buffer result;
-	if (1!=BN_mul(bn_tmp.get(),bn_b.get(),bn_tmp.get(),ctx.get()))
+	if (1!=BN_mul(bn_tmp.get(),bn_b.get(),bn_tmp.get(),ctx))
     {
         throw(Openssl_error("Multiplication failed (bxc)"));
     }
 
-	if (1!=BN_mod_add(bn_tmp.get(),bn_a.get(),bn_tmp.get(),bn_n.get(),ctx.get()))
+	if (1!=BN_mod_add(bn_tmp.get(),bn_a.get(),bn_tmp.get(),bn_n.get(),ctx))
     {
         throw(Openssl_error("Addition failed (a+bxc)"));
     }
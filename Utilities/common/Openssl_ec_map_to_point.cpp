@@ -48,6 +48,7 @@
 #include "Openssl_bn_utils.h"
 #include "Openssl_ec_utils.h"
 #include "Openssl_ec_map_to_point.h"
+#include "Bnp256_map_to_point.h"
 
 // Prepends a counter to the initial value and calculates a test point,
 // s_2=counter+initial_value, test point=(sha256(s_2), y_2). If the point
@@ -61,11 +62,11 @@ uint32_t max_iter
 {
 	G1_point pt;
 	// Get the curve parameters
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr p_bn=new_bn();
 	Bn_ptr a_bn=new_bn();
 	Bn_ptr b_bn=new_bn();
-	int rc=EC_GROUP_get_curve_GFp(ecgrp.get(),p_bn.get(),a_bn.get(),b_bn.get(),ctx.get());
+	int rc=EC_GROUP_get_curve_GFp(ecgrp.get(),p_bn.get(),a_bn.get(),b_bn.get(),ctx);
 	if (rc!=1)
 	{
 		throw(Openssl_error("map_to_point: failed to get the curve parameters"));
@@ -86,11 +87,11 @@ uint32_t max_iter
 		x_2=bb_mod(sha256_bb(s_2),p_bb);
 		bin2bn(&x_2[0],x_2.size(),x_bn.get());
 
-		BN_mod_sqr(xsq_bn.get(),x_bn.get(),p_bn.get(),ctx.get());
-		BN_mod_add(ysq_bn.get(),x_bn.get(),a_bn.get(),p_bn.get(),ctx.get());
-		BN_mod_mul(ysq_bn.get(),ysq_bn.get(),xsq_bn.get(),p_bn.get(),ctx.get());
-		BN_mod_add(ysq_bn.get(),ysq_bn.get(),b_bn.get(),p_bn.get(),ctx.get());
-		BN_mod_sqrt(y_bn.get(),ysq_bn.get(),p_bn.get(),ctx.get());
+		BN_mod_sqr(xsq_bn.get(),x_bn.get(),p_bn.get(),ctx);
+		BN_mod_add(ysq_bn.get(),x_bn.get(),a_bn.get(),p_bn.get(),ctx);
+		BN_mod_mul(ysq_bn.get(),ysq_bn.get(),xsq_bn.get(),p_bn.get(),ctx);
+		BN_mod_add(ysq_bn.get(),ysq_bn.get(),b_bn.get(),p_bn.get(),ctx);
+		BN_mod_sqrt(y_bn.get(),ysq_bn.get(),p_bn.get(),ctx);
 		y_2=bn2bb(y_bn.get());
 		pt=std::make_pair(x_2,y_2);
 		point_on_curve=point_is_on_curve(ecgrp,pt);
@@ -116,14 +117,8 @@ G1_point point_from_basename(Byte_buffer const& bsn)
     G1_point map_pt;
     if (bsn.size()!=0)
     {
-        Ec_group_ptr ecgrp=new_ec_group("bnp256");
-        if (ecgrp==NULL)
-        {
-            throw(Openssl_error("Error generating the curve"));
-        }
-            
         uint32_t max_map_tries{10};
-        map_pt=map_to_point(ecgrp,bsn,max_map_tries);
+        map_pt=bnp256_map_to_point(bsn,max_map_tries);
     }
     return map_pt;    
 }
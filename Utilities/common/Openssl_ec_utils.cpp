@@ -39,6 +39,7 @@
 
 
 #include <exception>
+#include <openssl/opensslv.h>
 #include "Openssl_utils.h"
 #include "Number_conversions.h"
 #include "Openssl_ec_utils.h"
@@ -49,7 +50,7 @@ Ec_group_ptr new_ec_group(std::string const& curve_name)
     EC_GROUP* ecgrp=nullptr;
     if (curve_name=="bnp256")
     {
-        ecgrp=get_ec_group_bnp256();
+        ecgrp=EC_GROUP_dup(bnp256_ec_group().get());
     }
     else
     {
@@ -64,6 +65,38 @@ Ec_group_ptr new_ec_group(std::string const& curve_name)
     return Ec_group_ptr(ecgrp,::EC_GROUP_free);
 }
 
+namespace
+{
+Ec_group_ptr make_bnp256_ec_group()
+{
+    Ec_group_ptr ecgrp(get_ec_group_bnp256(),::EC_GROUP_free);
+    if (ecgrp.get()==nullptr)
+    {
+        throw(Openssl_error("Error generating the BN_P256 curve"));
+    }
+    BN_CTX* ctx=thread_bn_ctx();
+    if (1!=EC_GROUP_check(ecgrp.get(),ctx))
+    {
+        throw(Openssl_error("BN_P256 curve: EC_GROUP_check failed"));
+    }
+#if OPENSSL_VERSION_NUMBER<0x30000000L
+    // Deprecated in OpenSSL 3.0
+    if (1!=EC_GROUP_precompute_mult(ecgrp.get(),ctx))
+    {
+        throw(Openssl_error("BN_P256 curve: EC_GROUP_precompute_mult failed"));
+    }
+#endif
+    return ecgrp;
+}
+}
+
+Ec_group_ptr const& bnp256_ec_group()
+{
+    // Initialisation of a local static is thread safe
+    static Ec_group_ptr const ecgrp=make_bnp256_ec_group();
+    return ecgrp;
+}
+
 Ec_key_ptr new_ec_key()
 {
     return Ec_key_ptr(EC_KEY_new(), ::EC_KEY_free);
@@ -82,11 +115,11 @@ G1_point point2bb(Ec_group_ptr const& ecgrp,Ec_point_ptr const& point)
 G1_point point2bb0(Ec_group_ptr const& ecgrp, Ec_point_ptr0 point)
 {
 	G1_point result;
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr x_bn=new_bn();
 	Bn_ptr y_bn=new_bn();
 
-	if(1!=EC_POINT_get_affine_coordinates_GFp(ecgrp.get(),point,x_bn.get(),y_bn.get(),ctx.get()))
+	if(1!=EC_POINT_get_affine_coordinates_GFp(ecgrp.get(),point,x_bn.get(),y_bn.get(),ctx))
 	{
 		throw(Openssl_error("point2bb0 failed"));
 	}
@@ -101,13 +134,13 @@ G1_point point2bb0(Ec_group_ptr const& ecgrp, Ec_point_ptr0 point)
 // Pass in the point so we don't worry about cleaning up
 void bb2point(Ec_group_ptr const& ecgrp,G1_point const& pt_bb, Ec_point_ptr& pt)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr x_bn=new_bn();
 	Bn_ptr y_bn=new_bn();
 	BN_bin2bn(&pt_bb.first[0],pt_bb.first.size(),x_bn.get());
 	BN_bin2bn(&pt_bb.second[0],pt_bb.second.size(),y_bn.get());
 
-	if (1!=EC_POINT_set_affine_coordinates_GFp(ecgrp.get(),pt.get(),x_bn.get(),y_bn.get(),ctx.get()))
+	if (1!=EC_POINT_set_affine_coordinates_GFp(ecgrp.get(),pt.get(),x_bn.get(),y_bn.get(),ctx))
 	{
 		throw(Openssl_error("bb2point failed"));
 	}
@@ -115,7 +148,6 @@ void bb2point(Ec_group_ptr const& ecgrp,G1_point const& pt_bb, Ec_point_ptr& pt)
 
 bool point_is_on_curve(Ec_group_ptr const& ecgrp,G1_point const& pt_bb)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
 	Ec_point_ptr pt=new_ec_point(ecgrp);
 
     bool result=true;
@@ -151,7 +183,7 @@ G1_point pt_a_bb,
 G1_point pt_b_bb
 )
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Ec_point_ptr pt_a=new_ec_point(ecgrp);
 	bb2point(ecgrp,pt_a_bb,pt_a);
 	Ec_point_ptr pt_b=new_ec_point(ecgrp);
@@ -160,7 +192,7 @@ G1_point pt_b_bb
 
 	G1_point result;
 
-	if (1!=EC_POINT_add(ecgrp.get(),pt_r.get(),pt_a.get(),pt_b.get(),ctx.get()))
+	if (1!=EC_POINT_add(ecgrp.get(),pt_r.get(),pt_a.get(),pt_b.get(),ctx))
 	{
 		std::cout << "ec_point_add failed\n";
 		handle_openssl_error();
@@ -178,13 +210,13 @@ Ec_group_ptr const& ecgrp,
 Byte_buffer const& multiplier
 )
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr m_bn=new_bn();
   	bin2bn(&multiplier[0],multiplier.size(),m_bn.get());
 	Ec_point_ptr res=new_ec_point(ecgrp);
 	G1_point result;
 
-	if (1!=EC_POINT_mul(ecgrp.get(),res.get(),m_bn.get(),NULL,NULL,ctx.get()))
+	if (1!=EC_POINT_mul(ecgrp.get(),res.get(),m_bn.get(),NULL,NULL,ctx))
 	{
 		std::cout << "ec_generator_mul failed\n";
 		handle_openssl_error();
@@ -203,7 +235,7 @@ Byte_buffer const& multiplier,
 G1_point const& pt_bb
 )
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Bn_ptr m_bn=new_bn();
   	bin2bn(&multiplier[0],multiplier.size(),m_bn.get());
 	Ec_point_ptr pt=new_ec_point(ecgrp);
@@ -212,7 +244,7 @@ G1_point const& pt_bb
 
 	G1_point result;
 
-	if (1!=EC_POINT_mul(ecgrp.get(),res.get(),NULL,pt.get(),m_bn.get(),ctx.get()))
+	if (1!=EC_POINT_mul(ecgrp.get(),res.get(),NULL,pt.get(),m_bn.get(),ctx))
 	{
 		std::cout << "ec_point_mul failed\n";
 		handle_openssl_error();
@@ -231,13 +263,13 @@ Ec_group_ptr const& ecgrp,
 G1_point const& pt_bb
 )
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
+	BN_CTX* ctx=thread_bn_ctx();
 	Ec_point_ptr pt=new_ec_point(ecgrp);
 	bb2point(ecgrp,pt_bb,pt);
 
 	G1_point result;
 
-	if (1!=EC_POINT_invert(ecgrp.get(),pt.get(),ctx.get()))
+	if (1!=EC_POINT_invert(ecgrp.get(),pt.get(),ctx))
 	{
 		std::cout << "ec_point_invert failed\n";
 		handle_openssl_error();
@@ -252,7 +284,6 @@ G1_point const& pt_bb
 
 Ec_key_pair_bb get_new_key_pair(Ec_group_ptr const& ecgrp)
 {
-	Bn_ctx_ptr ctx=new_bn_ctx();
 	Ec_key_pair_bb result;
 	Ec_key_ptr new_key=new_ec_key();
 	if (1!=EC_KEY_set_group(new_key.get(),ecgrp.get()))
@@ -0,0 +1,216 @@
+/*******************************************************************************
+* File:        Openssl_g1.cpp
+* Description: A G1 point type using OpenSSL, with the same interface as G1_ecp
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#include <stdexcept>
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Number_conversions.h"
+#include "Openssl_utils.h"
+#include "Openssl_bn_utils.h"
+#include "Openssl_ec_utils.h"
+#include "Openssl_g1.h"
+
+namespace
+{
+Bn_ptr scalar_to_bn(Byte_buffer const& k)
+{
+	Bn_ptr bn=new_bn();
+	if (k.size()!=0)
+	{
+		bin2bn(&k[0],k.size(),bn.get());
+	}
+	return bn;
+}
+}
+
+Openssl_g1::Openssl_g1() : pt_(new_ec_point(bnp256_ec_group()))
+{
+	if (1!=EC_POINT_set_to_infinity(bnp256_ec_group().get(),pt_.get()))
+	{
+		throw(Openssl_error("Openssl_g1: setting the point at infinity failed"));
+	}
+}
+
+Openssl_g1::Openssl_g1(G1_point const& pt) : pt_(new_ec_point(bnp256_ec_group()))
+{
+	Ec_group_ptr const& ecgrp=bnp256_ec_group();
+	if (!point_is_on_curve(ecgrp,pt))
+	{
+		throw(Openssl_error("Openssl_g1: point is not on the curve"));
+	}
+	bb2point(ecgrp,pt,pt_);
+}
+
+Openssl_g1::Openssl_g1(Openssl_g1 const& pt) : pt_(EC_POINT_dup(pt.pt_.get(),bnp256_ec_group().get()),::EC_POINT_free)
+{
+	if (pt_.get()==nullptr)
+	{
+		throw(Openssl_error("Openssl_g1: copying the point failed"));
+	}
+}
+
+Openssl_g1& Openssl_g1::operator=(Openssl_g1 const& pt)
+{
+	if (1!=EC_POINT_copy(pt_.get(),pt.pt_.get()))
+	{
+		throw(Openssl_error("Openssl_g1: copying the point failed"));
+	}
+	return *this;
+}
+
+Openssl_g1 Openssl_g1::generator()
+{
+	Openssl_g1 g;
+	if (1!=EC_POINT_copy(g.pt_.get(),EC_GROUP_get0_generator(bnp256_ec_group().get())))
+	{
+		throw(Openssl_error("Openssl_g1: copying the generator failed"));
+	}
+	return g;
+}
+
+bool Openssl_g1::is_infinity() const
+{
+	return EC_POINT_is_at_infinity(bnp256_ec_group().get(),pt_.get())==1;
+}
+
+bool Openssl_g1::operator==(Openssl_g1 const& rhs) const
+{
+	return EC_POINT_cmp(bnp256_ec_group().get(),pt_.get(),rhs.pt_.get(),thread_bn_ctx())==0;
+}
+
+Openssl_g1& Openssl_g1::operator+=(Openssl_g1 const& rhs)
+{
+	if (1!=EC_POINT_add(bnp256_ec_group().get(),pt_.get(),pt_.get(),rhs.pt_.get(),thread_bn_ctx()))
+	{
+		throw(Openssl_error("Openssl_g1: point addition failed"));
+	}
+	return *this;
+}
+
+Openssl_g1& Openssl_g1::operator-=(Openssl_g1 const& rhs)
+{
+	return *this+=-rhs;
+}
+
+Openssl_g1 Openssl_g1::operator-() const
+{
+	Openssl_g1 neg(*this);
+	if (1!=EC_POINT_invert(bnp256_ec_group().get(),neg.pt_.get(),thread_bn_ctx()))
+	{
+		throw(Openssl_error("Openssl_g1: point inversion failed"));
+	}
+	return neg;
+}
+
+Openssl_g1& Openssl_g1::operator*=(Byte_buffer const& k)
+{
+	Bn_ptr k_bn=scalar_to_bn(k);
+	if (1!=EC_POINT_mul(bnp256_ec_group().get(),pt_.get(),NULL,pt_.get(),k_bn.get(),thread_bn_ctx()))
+	{
+		throw(Openssl_error("Openssl_g1: point multiplication failed"));
+	}
+	return *this;
+}
+
+G1_point Openssl_g1::to_g1_point() const
+{
+	if (is_infinity())
+	{
+		throw(Openssl_error("Openssl_g1: the point at infinity has no affine coordinates"));
+	}
+	return point2bb0(bnp256_ec_group(),pt_.get());
+}
+
+Openssl_g1 operator+(Openssl_g1 a, Openssl_g1 const& b)
+{
+	a+=b;
+	return a;
+}
+
+Openssl_g1 operator-(Openssl_g1 a, Openssl_g1 const& b)
+{
+	a-=b;
+	return a;
+}
+
+Openssl_g1 operator*(Byte_buffer const& k, Openssl_g1 pt)
+{
+	pt*=k;
+	return pt;
+}
+
+Openssl_g1 openssl_generator_mul(Byte_buffer const& k)
+{
+	Openssl_g1 result;
+	Bn_ptr k_bn=scalar_to_bn(k);
+	if (1!=EC_POINT_mul(bnp256_ec_group().get(),result.point(),k_bn.get(),NULL,NULL,thread_bn_ctx()))
+	{
+		throw(Openssl_error("openssl_generator_mul: point multiplication failed"));
+	}
+	return result;
+}
+
+Openssl_g1 openssl_multi_mul(std::vector<Byte_buffer> const& scalars, std::vector<Openssl_g1> const& points)
+{
+	if (scalars.size()!=points.size())
+	{
+		throw(std::runtime_error("openssl_multi_mul: the number of scalars and points differ"));
+	}
+	Openssl_g1 result;
+	for (size_t i=0;i<points.size();++i)
+	{
+		result+=scalars[i]*points[i];
+	}
+	return result;
+}
+
+std::vector<G1_point> openssl_batch_to_g1_points(std::vector<Openssl_g1> const& pts)
+{
+	std::vector<G1_point> result;
+	result.reserve(pts.size());
+	for (auto const& pt : pts)
+	{
+		result.push_back(pt.to_g1_point());
+	}
+	return result;
+}
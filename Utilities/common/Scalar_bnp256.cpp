@@ -0,0 +1,275 @@
+/*******************************************************************************
+* File:        Scalar_bnp256.cpp
+* Description: Integers mod the order of the BN_P256 group, without heap allocation
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#include <algorithm>
+#include "Scalar_bnp256.h"
+#include "Sha.h"
+#include "Get_random_bytes.h"
+
+namespace
+{
+using Limbs=std::array<uint32_t,Scalar_bnp256::n_limbs>;
+
+// n, least significant limb first
+constexpr Limbs order{{
+	0xd10b500d, 0xf62d536c, 0x1299921a, 0x0cdc65fb,
+	0xee71a49e, 0x46e5f25e, 0xfffcf0cd, 0xffffffff}};
+
+// -n^-1 mod 2^32
+constexpr uint32_t order_inv=0xc9c6813b;
+
+// R^2 mod n, with R=2^256
+constexpr Limbs r_squared{{
+	0x8f4c4808, 0xaf948aa3, 0x26123232, 0xbd789efd,
+	0xeb526be7, 0x117fd17c, 0xfb8f407a, 0x2bfc4998}};
+
+// Subtracts n from a if a>=n, where carry is a bit above the top limb. The
+// choice is made with a mask, not a branch, as the values may be secret.
+void reduce_once(Limbs& a, uint32_t carry)
+{
+	Limbs d;
+	uint64_t borrow=0;
+	for (size_t i=0;i<a.size();++i)
+	{
+		uint64_t t=static_cast<uint64_t>(a[i])-order[i]-borrow;
+		d[i]=static_cast<uint32_t>(t);
+		borrow=(t>>32)&1;
+	}
+	// Keep a if it was less than n, i.e. there was a borrow and no carry
+	uint32_t keep_a=0-static_cast<uint32_t>(borrow&(carry^1));
+	for (size_t i=0;i<a.size();++i)
+	{
+		a[i]=(a[i]&keep_a)|(d[i]&~keep_a);
+	}
+}
+
+// a+b mod n, for a,b<n
+void add_mod(Limbs& a, Limbs const& b)
+{
+	uint64_t carry=0;
+	for (size_t i=0;i<a.size();++i)
+	{
+		uint64_t t=static_cast<uint64_t>(a[i])+b[i]+carry;
+		a[i]=static_cast<uint32_t>(t);
+		carry=t>>32;
+	}
+	reduce_once(a,static_cast<uint32_t>(carry));
+}
+
+// a*b*R^-1 mod n, for a,b<n (CIOS Montgomery multiplication)
+Limbs mont_mul(Limbs const& a, Limbs const& b)
+{
+	constexpr size_t s=Scalar_bnp256::n_limbs;
+	uint32_t t[s+2]={0};
+	for (size_t i=0;i<s;++i)
+	{
+		uint64_t c=0;
+		for (size_t j=0;j<s;++j)
+		{
+			uint64_t x=t[j]+static_cast<uint64_t>(a[j])*b[i]+c;
+			t[j]=static_cast<uint32_t>(x);
+			c=x>>32;
+		}
+		uint64_t x=t[s]+c;
+		t[s]=static_cast<uint32_t>(x);
+		t[s+1]=static_cast<uint32_t>(x>>32);
+
+		uint32_t m=t[0]*order_inv;
+		x=t[0]+static_cast<uint64_t>(m)*order[0];
+		c=x>>32;
+		for (size_t j=1;j<s;++j)
+		{
+			x=t[j]+static_cast<uint64_t>(m)*order[j]+c;
+			t[j-1]=static_cast<uint32_t>(x);
+			c=x>>32;
+		}
+		x=t[s]+c;
+		t[s-1]=static_cast<uint32_t>(x);
+		t[s]=t[s+1]+static_cast<uint32_t>(x>>32);
+	}
+	Limbs r;
+	for (size_t i=0;i<s;++i)
+	{
+		r[i]=t[i];
+	}
+	reduce_once(r,t[s]);
+	return r;
+}
+
+// Up to 32 big-endian bytes as limbs, reduced mod n. As n>2^255, one
+// subtraction is enough.
+Limbs chunk_to_limbs(uint8_t const* bytes, size_t size)
+{
+	Limbs r{};
+	for (size_t i=0;i<size;++i)
+	{
+		size_t pos=size-1-i;    // Byte i from the least significant end
+		r[i/4]|=static_cast<uint32_t>(bytes[pos])<<(8*(i%4));
+	}
+	reduce_once(r,0);
+	return r;
+}
+}
+
+Scalar_bnp256::Scalar_bnp256(Byte_buffer const& bb) : Scalar_bnp256(bb.cdata(),bb.size())
+{
+}
+
+Scalar_bnp256::Scalar_bnp256(uint8_t const* bytes, size_t size) : v_{}
+{
+	// Horner's rule in 256-bit chunks, from the most significant end:
+	// v=v*2^256+chunk, with v*2^256=mont_mul(v,R^2)
+	size_t first=size%n_bytes;
+	if (first==0 && size>0)
+	{
+		first=n_bytes;
+	}
+	size_t pos=0;
+	size_t chunk=first;
+	while (pos<size)
+	{
+		v_=mont_mul(v_,r_squared);
+		add_mod(v_,chunk_to_limbs(bytes+pos,chunk));
+		pos+=chunk;
+		chunk=n_bytes;
+	}
+}
+
+bool Scalar_bnp256::is_zero() const
+{
+	uint32_t acc=0;
+	for (auto l : v_)
+	{
+		acc|=l;
+	}
+	return acc==0;
+}
+
+bool Scalar_bnp256::operator==(Scalar_bnp256 const& rhs) const
+{
+	uint32_t acc=0;
+	for (size_t i=0;i<n_limbs;++i)
+	{
+		acc|=v_[i]^rhs.v_[i];
+	}
+	return acc==0;
+}
+
+Scalar_bnp256& Scalar_bnp256::operator+=(Scalar_bnp256 const& rhs)
+{
+	add_mod(v_,rhs.v_);
+	return *this;
+}
+
+Scalar_bnp256& Scalar_bnp256::operator-=(Scalar_bnp256 const& rhs)
+{
+	add_mod(v_,(-rhs).v_);
+	return *this;
+}
+
+Scalar_bnp256& Scalar_bnp256::operator*=(Scalar_bnp256 const& rhs)
+{
+	// (a*b*R^-1)*R^2*R^-1=a*b
+	v_=mont_mul(mont_mul(v_,rhs.v_),r_squared);
+	return *this;
+}
+
+Scalar_bnp256 Scalar_bnp256::operator-() const
+{
+	// n-v, which is n for v=0, so reduce once more
+	Scalar_bnp256 r;
+	uint64_t borrow=0;
+	for (size_t i=0;i<n_limbs;++i)
+	{
+		uint64_t t=static_cast<uint64_t>(order[i])-v_[i]-borrow;
+		r.v_[i]=static_cast<uint32_t>(t);
+		borrow=(t>>32)&1;
+	}
+	reduce_once(r.v_,0);
+	return r;
+}
+
+void Scalar_bnp256::to_bytes(uint8_t* out) const
+{
+	for (size_t i=0;i<n_bytes;++i)
+	{
+		out[n_bytes-1-i]=static_cast<uint8_t>(v_[i/4]>>(8*(i%4)));
+	}
+}
+
+Byte_buffer Scalar_bnp256::to_byte_buffer() const
+{
+	uint8_t bytes[n_bytes];
+	to_bytes(bytes);
+	size_t start=0;
+	while (start<n_bytes && bytes[start]==0)
+	{
+		++start;
+	}
+	return Byte_buffer(bytes+start,n_bytes-start);
+}
+
+Scalar_bnp256 hash_to_scalar(Byte_buffer const& bb)
+{
+	uint8_t digest[sha256_digest_size];
+	Sha256_hasher hasher;
+	hasher.update(bb).finish(digest);
+	return Scalar_bnp256(digest,sha256_digest_size);
+}
+
+Scalar_bnp256 random_scalar_mod_n(Random_byte_generator& rbg)
+{
+	uint8_t bytes[Scalar_bnp256::n_bytes+16];
+	Scalar_bnp256 k;
+	do
+	{
+		rbg.fill(bytes,sizeof(bytes));
+		k=Scalar_bnp256(bytes,sizeof(bytes));
+	} while (k.is_zero());
+	std::fill(bytes,bytes+sizeof(bytes),0);
+	return k;
+}
+
+Scalar_bnp256 random_scalar_mod_n()
+{
+	return random_scalar_mod_n(thread_random_generator());
+}
@@ -39,18 +39,156 @@
 *******************************************************************************/
 
 
-#include <openssl/sha.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
 #include "Byte_buffer.h"
+#include "Sha.h"
 
+namespace
+{
+EVP_MD const* sha256_md()
+{
+#if OPENSSL_VERSION_NUMBER>=0x30000000L
+	// Fetched once, rather than looked up by EVP_sha256() on each use
+	static EVP_MD const* md=[]{
+		EVP_MD const* fetched=EVP_MD_fetch(nullptr,"SHA256",nullptr);
+		return (fetched!=nullptr)?fetched:EVP_sha256();
+	}();
+	return md;
+#else
+	// OpenSSL 1.1 (e.g. on the Raspberry Pi) has no EVP_MD_fetch
+	return EVP_sha256();
+#endif
+}
 
-Byte_buffer sha256_bb(Byte_buffer const& bb)
+// The contexts not in use on this thread
+struct Context_list
 {
-    Byte_buffer hash(SHA256_DIGEST_LENGTH,0);
-    SHA256_CTX sha256;
-    SHA256_Init(&sha256);
-    SHA256_Update(&sha256, &bb[0], bb.size());
-    SHA256_Final(&hash[0], &sha256);
+	std::vector<EVP_MD_CTX*> contexts;
+	~Context_list()
+	{
+		for (auto ctx : contexts)
+		{
+			EVP_MD_CTX_free(ctx);
+		}
+	}
+};
 
-    return hash;
+thread_local Context_list free_contexts;
+
+const Byte zeros[sha256_digest_size]={};
+}
+
+Sha256_hasher::Sha256_hasher() : ctx_(nullptr), finished_(false), pending_size_(0)
+{
+	if (free_contexts.contexts.empty())
+	{
+		ctx_=EVP_MD_CTX_new();
+		if (ctx_==nullptr)
+		{
+			throw(std::runtime_error("Sha256_hasher: unable to allocate a context"));
+		}
+	}
+	else
+	{
+		ctx_=free_contexts.contexts.back();
+		free_contexts.contexts.pop_back();
+	}
+	if (EVP_DigestInit_ex(ctx_,sha256_md(),nullptr)!=1)
+	{
+		EVP_MD_CTX_free(ctx_);
+		throw(std::runtime_error("Sha256_hasher: unable to initialise the hash"));
+	}
 }
 
+Sha256_hasher::~Sha256_hasher()
+{
+	free_contexts.contexts.push_back(ctx_);
+}
+
+void Sha256_hasher::flush()
+{
+	if (pending_size_!=0 && EVP_DigestUpdate(ctx_,pending_,pending_size_)!=1)
+	{
+		throw(std::runtime_error("Sha256_hasher: update failed"));
+	}
+	pending_size_=0;
+}
+
+Sha256_hasher& Sha256_hasher::update(Byte_const_ptr data, size_t len)
+{
+	if (finished_)
+	{
+		EVP_DigestInit_ex(ctx_,sha256_md(),nullptr);
+		finished_=false;
+	}
+	if (pending_size_+len<=sizeof(pending_))
+	{
+		if (len!=0)
+		{
+			std::memcpy(pending_+pending_size_,data,len);
+			pending_size_+=len;
+		}
+		return *this;
+	}
+	flush();
+	if (len<sizeof(pending_))
+	{
+		std::memcpy(pending_,data,len);
+		pending_size_=len;
+	}
+	else if (EVP_DigestUpdate(ctx_,data,len)!=1)
+	{
+		throw(std::runtime_error("Sha256_hasher: update failed"));
+	}
+	return *this;
+}
+
+Sha256_hasher& Sha256_hasher::update_padded(Byte_view bv, size_t length)
+{
+	if (bv.size()>length)
+	{
+		throw(std::runtime_error("Sha256_hasher::update_padded: already longer than this"));
+	}
+	size_t padding=length-bv.size();
+	while (padding!=0)
+	{
+		size_t n=std::min(padding,sizeof(zeros));
+		update(zeros,n);
+		padding-=n;
+	}
+	return update(bv);
+}
+
+void Sha256_hasher::finish(Byte_ptr digest)
+{
+	if (finished_)
+	{
+		EVP_DigestInit_ex(ctx_,sha256_md(),nullptr);
+	}
+	flush();
+	unsigned int len=0;
+	if (EVP_DigestFinal_ex(ctx_,digest,&len)!=1 || len!=sha256_digest_size)
+	{
+		throw(std::runtime_error("Sha256_hasher: finish failed"));
+	}
+	finished_=true;
+}
+
+Byte_buffer Sha256_hasher::finish()
+{
+	Byte_buffer hash(sha256_digest_size,0);
+	finish(hash.data());
+	return hash;
+}
+
+Byte_buffer sha256_bb(Byte_buffer const& bb)
+{
+	Sha256_hasher hasher;
+	hasher.update(bb);
+	return hasher.finish();
+}
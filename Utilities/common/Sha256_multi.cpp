@@ -0,0 +1,554 @@
+/*******************************************************************************
+* File:        Sha256_multi.cpp
+* Description: SHA-256 of several independent messages at once
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "Byte_buffer.h"
+#include "Sha.h"
+#include "Sha256_multi.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SHA256_MULTI_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace
+{
+const uint32_t k256[64]={
+	0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+	0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+	0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+	0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+	0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+	0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+	0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+	0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+};
+
+const uint32_t h256_initial[8]={
+	0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19
+};
+
+const size_t block_size=64;
+
+// A message as a sequence of blocks. Whole blocks are read from the message
+// itself, the rest of it, the padding and the length go in the tail.
+struct Message_blocks
+{
+	Byte_const_ptr data;
+	size_t n_data_blocks;
+	size_t n_blocks;
+	Byte tail[2*block_size];
+
+	void set(Byte_view msg)
+	{
+		data=msg.data();
+		n_data_blocks=msg.size()/block_size;
+		size_t rest=msg.size()%block_size;
+		size_t n_tail_blocks=(rest+9<=block_size)?1:2;
+		std::memset(tail,0,n_tail_blocks*block_size);
+		if (rest!=0)
+		{
+			std::memcpy(tail,data+n_data_blocks*block_size,rest);
+		}
+		tail[rest]=0x80;
+		uint64_t bits=uint64_t(msg.size())*8;
+		for (size_t i=0;i<8;++i)
+		{
+			tail[n_tail_blocks*block_size-1-i]=static_cast<Byte>(bits>>(8*i));
+		}
+		n_blocks=n_data_blocks+n_tail_blocks;
+	}
+
+	Byte_const_ptr block(size_t i) const
+	{
+		return (i<n_data_blocks)?data+i*block_size:tail+(i-n_data_blocks)*block_size;
+	}
+};
+
+inline uint32_t rotr(uint32_t x, int n)
+{
+	return (x>>n)|(x<<(32-n));
+}
+
+void store_digest(uint32_t const* state, Byte_ptr digest)
+{
+	for (size_t i=0;i<8;++i)
+	{
+		digest[4*i]=static_cast<Byte>(state[i]>>24);
+		digest[4*i+1]=static_cast<Byte>(state[i]>>16);
+		digest[4*i+2]=static_cast<Byte>(state[i]>>8);
+		digest[4*i+3]=static_cast<Byte>(state[i]);
+	}
+}
+
+void compress_generic(uint32_t* state, Byte_const_ptr block)
+{
+	uint32_t w[64];
+	for (size_t t=0;t<16;++t)
+	{
+		w[t]=(uint32_t(block[4*t])<<24)|(uint32_t(block[4*t+1])<<16)|(uint32_t(block[4*t+2])<<8)|block[4*t+3];
+	}
+	for (size_t t=16;t<64;++t)
+	{
+		uint32_t s0=rotr(w[t-15],7)^rotr(w[t-15],18)^(w[t-15]>>3);
+		uint32_t s1=rotr(w[t-2],17)^rotr(w[t-2],19)^(w[t-2]>>10);
+		w[t]=w[t-16]+s0+w[t-7]+s1;
+	}
+	uint32_t a=state[0],b=state[1],c=state[2],d=state[3],e=state[4],f=state[5],g=state[6],h=state[7];
+	for (size_t t=0;t<64;++t)
+	{
+		uint32_t t1=h+(rotr(e,6)^rotr(e,11)^rotr(e,25))+((e&f)^(~e&g))+k256[t]+w[t];
+		uint32_t t2=(rotr(a,2)^rotr(a,13)^rotr(a,22))+((a&b)^(a&c)^(b&c));
+		h=g;
+		g=f;
+		f=e;
+		e=d+t1;
+		d=c;
+		c=b;
+		b=a;
+		a=t1+t2;
+	}
+	state[0]+=a;
+	state[1]+=b;
+	state[2]+=c;
+	state[3]+=d;
+	state[4]+=e;
+	state[5]+=f;
+	state[6]+=g;
+	state[7]+=h;
+}
+
+void hash_generic(Byte_view const* msgs, Byte_ptr const* digests, size_t count)
+{
+	Message_blocks blocks;
+	for (size_t m=0;m<count;++m)
+	{
+		blocks.set(msgs[m]);
+		uint32_t state[8];
+		std::memcpy(state,h256_initial,sizeof(state));
+		for (size_t b=0;b<blocks.n_blocks;++b)
+		{
+			compress_generic(state,blocks.block(b));
+		}
+		store_digest(state,digests[m]);
+	}
+}
+
+#ifdef SHA256_MULTI_X86
+// Checked once, as cpuid is slow, particularly in a virtual machine
+bool cpu_has_sha_ni()
+{
+	static const bool has_sha_ni=[]{
+		unsigned int a,b,c,d;
+		if (__get_cpuid_count(7,0,&a,&b,&c,&d)==0)
+		{
+			return false;
+		}
+		return (b&(1u<<29))!=0 && __builtin_cpu_supports("sse4.1");
+	}();
+	return has_sha_ni;
+}
+
+bool cpu_has_avx2()
+{
+	static const bool has_avx2=__builtin_cpu_supports("avx2");
+	return has_avx2;
+}
+
+// Four rounds using the schedule words in x. While there are more words to
+// come the next four replace the oldest, which are in next.
+__attribute__((target("sha,sse4.1"),always_inline))
+inline void sha_ni_rounds(__m128i& abef, __m128i& cdgh, int g, __m128i x, __m128i& next, __m128i after_next,
+                          __m128i prev)
+{
+	__m128i wk=_mm_add_epi32(x,_mm_loadu_si128(reinterpret_cast<__m128i const*>(k256+4*g)));
+	cdgh=_mm_sha256rnds2_epu32(cdgh,abef,wk);
+	abef=_mm_sha256rnds2_epu32(abef,cdgh,_mm_shuffle_epi32(wk,0x0e));
+	if (g>=3 && g<15)
+	{
+		next=_mm_sha256msg1_epu32(next,after_next);
+		next=_mm_add_epi32(next,_mm_alignr_epi8(x,prev,4));
+		next=_mm_sha256msg2_epu32(next,x);
+	}
+}
+
+__attribute__((target("sha,sse4.1"),always_inline))
+inline void load_sha_ni_block(Byte_const_ptr block, __m128i& x0, __m128i& x1, __m128i& x2, __m128i& x3)
+{
+	const __m128i byte_swap=_mm_set_epi64x(0x0c0d0e0f08090a0bULL,0x0405060700010203ULL);
+	x0=_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(block)),byte_swap);
+	x1=_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(block+16)),byte_swap);
+	x2=_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(block+32)),byte_swap);
+	x3=_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(block+48)),byte_swap);
+}
+
+// The SHA extensions hold the state as ABEF and CDGH
+__attribute__((target("sha,sse4.1"),always_inline))
+inline void compress_sha_ni(__m128i& abef, __m128i& cdgh, Byte_const_ptr block)
+{
+	__m128i abef_start=abef,cdgh_start=cdgh;
+	__m128i x0,x1,x2,x3;
+	load_sha_ni_block(block,x0,x1,x2,x3);
+#pragma GCC unroll 4
+	for (int g=0;g<16;g+=4)
+	{
+		sha_ni_rounds(abef,cdgh,g,x0,x1,x2,x3);
+		sha_ni_rounds(abef,cdgh,g+1,x1,x2,x3,x0);
+		sha_ni_rounds(abef,cdgh,g+2,x2,x3,x0,x1);
+		sha_ni_rounds(abef,cdgh,g+3,x3,x0,x1,x2);
+	}
+	abef=_mm_add_epi32(abef,abef_start);
+	cdgh=_mm_add_epi32(cdgh,cdgh_start);
+}
+
+// Two streams together, so that the rounds of each fill the gaps left by the
+// latency of the other
+__attribute__((target("sha,sse4.1"),always_inline))
+inline void compress_sha_ni_x2(__m128i& abef_a, __m128i& cdgh_a, Byte_const_ptr block_a,
+                               __m128i& abef_b, __m128i& cdgh_b, Byte_const_ptr block_b)
+{
+	__m128i abef_a_start=abef_a,cdgh_a_start=cdgh_a,abef_b_start=abef_b,cdgh_b_start=cdgh_b;
+	__m128i a0,a1,a2,a3,b0,b1,b2,b3;
+	load_sha_ni_block(block_a,a0,a1,a2,a3);
+	load_sha_ni_block(block_b,b0,b1,b2,b3);
+#pragma GCC unroll 4
+	for (int g=0;g<16;g+=4)
+	{
+		sha_ni_rounds(abef_a,cdgh_a,g,a0,a1,a2,a3);
+		sha_ni_rounds(abef_b,cdgh_b,g,b0,b1,b2,b3);
+		sha_ni_rounds(abef_a,cdgh_a,g+1,a1,a2,a3,a0);
+		sha_ni_rounds(abef_b,cdgh_b,g+1,b1,b2,b3,b0);
+		sha_ni_rounds(abef_a,cdgh_a,g+2,a2,a3,a0,a1);
+		sha_ni_rounds(abef_b,cdgh_b,g+2,b2,b3,b0,b1);
+		sha_ni_rounds(abef_a,cdgh_a,g+3,a3,a0,a1,a2);
+		sha_ni_rounds(abef_b,cdgh_b,g+3,b3,b0,b1,b2);
+	}
+	abef_a=_mm_add_epi32(abef_a,abef_a_start);
+	cdgh_a=_mm_add_epi32(cdgh_a,cdgh_a_start);
+	abef_b=_mm_add_epi32(abef_b,abef_b_start);
+	cdgh_b=_mm_add_epi32(cdgh_b,cdgh_b_start);
+}
+
+__attribute__((target("sha,sse4.1")))
+void initial_sha_ni_state(__m128i& abef, __m128i& cdgh)
+{
+	__m128i abcd=_mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(h256_initial)),0xb1);
+	__m128i efgh=_mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(h256_initial+4)),0x1b);
+	abef=_mm_alignr_epi8(abcd,efgh,8);
+	cdgh=_mm_blend_epi16(efgh,abcd,0xf0);
+}
+
+__attribute__((target("sha,sse4.1")))
+void store_sha_ni_digest(__m128i abef, __m128i cdgh, Byte_ptr digest)
+{
+	__m128i feba=_mm_shuffle_epi32(abef,0x1b);
+	__m128i dchg=_mm_shuffle_epi32(cdgh,0xb1);
+	uint32_t state[8];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state),_mm_blend_epi16(feba,dchg,0xf0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(state+4),_mm_alignr_epi8(dchg,feba,8));
+	store_digest(state,digest);
+}
+
+// The blocks of one message from first on. The state is kept in registers
+// until all are done.
+__attribute__((target("sha,sse4.1")))
+void sha_ni_blocks(Message_blocks const& msg, size_t first, __m128i& abef, __m128i& cdgh)
+{
+	__m128i abef_r=abef,cdgh_r=cdgh;
+	for (size_t b=first;b<msg.n_blocks;++b)
+	{
+		compress_sha_ni(abef_r,cdgh_r,msg.block(b));
+	}
+	abef=abef_r;
+	cdgh=cdgh_r;
+}
+
+// The first n_blocks of two messages
+__attribute__((target("sha,sse4.1")))
+void sha_ni_blocks_x2(Message_blocks const* msgs, size_t n_blocks, __m128i* abef, __m128i* cdgh)
+{
+	__m128i abef_a=abef[0],cdgh_a=cdgh[0],abef_b=abef[1],cdgh_b=cdgh[1];
+	for (size_t b=0;b<n_blocks;++b)
+	{
+		compress_sha_ni_x2(abef_a,cdgh_a,msgs[0].block(b),abef_b,cdgh_b,msgs[1].block(b));
+	}
+	abef[0]=abef_a;
+	cdgh[0]=cdgh_a;
+	abef[1]=abef_b;
+	cdgh[1]=cdgh_b;
+}
+
+__attribute__((target("sha,sse4.1")))
+void hash_sha_ni(Byte_view const* msgs, Byte_ptr const* digests, size_t count)
+{
+	Message_blocks blocks[2];
+	__m128i abef[2],cdgh[2];
+	size_t m=0;
+	for (;m+1<count;m+=2)
+	{
+		blocks[0].set(msgs[m]);
+		blocks[1].set(msgs[m+1]);
+		initial_sha_ni_state(abef[0],cdgh[0]);
+		initial_sha_ni_state(abef[1],cdgh[1]);
+		size_t n_both=std::min(blocks[0].n_blocks,blocks[1].n_blocks);
+		sha_ni_blocks_x2(blocks,n_both,abef,cdgh);
+		for (size_t n=0;n<2;++n)
+		{
+			sha_ni_blocks(blocks[n],n_both,abef[n],cdgh[n]);
+			store_sha_ni_digest(abef[n],cdgh[n],digests[m+n]);
+		}
+	}
+	if (m<count)
+	{
+		blocks[0].set(msgs[m]);
+		initial_sha_ni_state(abef[0],cdgh[0]);
+		sha_ni_blocks(blocks[0],0,abef[0],cdgh[0]);
+		store_sha_ni_digest(abef[0],cdgh[0],digests[m]);
+	}
+}
+
+const size_t avx2_lanes=8;
+
+template<int n>
+__attribute__((target("avx2")))
+inline __m256i rotr8(__m256i x)
+{
+	return _mm256_or_si256(_mm256_srli_epi32(x,n),_mm256_slli_epi32(x,32-n));
+}
+
+// Loads eight words from each lane's block, so that w[i] holds word i of
+// every lane
+__attribute__((target("avx2")))
+inline void load_transposed(Byte_const_ptr const* blocks, size_t offset, __m256i* w)
+{
+	const __m256i byte_swap=_mm256_set_epi64x(0x0c0d0e0f08090a0bULL,0x0405060700010203ULL,
+	                                          0x0c0d0e0f08090a0bULL,0x0405060700010203ULL);
+	__m256i r[8],t[8],u[8];
+	for (size_t l=0;l<8;++l)
+	{
+		r[l]=_mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(blocks[l]+offset)),byte_swap);
+	}
+	for (size_t l=0;l<8;l+=2)
+	{
+		t[l]=_mm256_unpacklo_epi32(r[l],r[l+1]);
+		t[l+1]=_mm256_unpackhi_epi32(r[l],r[l+1]);
+	}
+	for (size_t l=0;l<8;l+=4)
+	{
+		u[l]=_mm256_unpacklo_epi64(t[l],t[l+2]);
+		u[l+1]=_mm256_unpackhi_epi64(t[l],t[l+2]);
+		u[l+2]=_mm256_unpacklo_epi64(t[l+1],t[l+3]);
+		u[l+3]=_mm256_unpackhi_epi64(t[l+1],t[l+3]);
+	}
+	for (size_t i=0;i<4;++i)
+	{
+		w[i]=_mm256_permute2x128_si256(u[i],u[i+4],0x20);
+		w[i+4]=_mm256_permute2x128_si256(u[i],u[i+4],0x31);
+	}
+}
+
+// One block for each lane. Lanes that are not active keep their state.
+__attribute__((target("avx2")))
+void compress_avx2(__m256i* state, Byte_const_ptr const* blocks, __m256i active)
+{
+	__m256i w[16];
+	load_transposed(blocks,0,w);
+	load_transposed(blocks,32,w+8);
+	__m256i a=state[0],b=state[1],c=state[2],d=state[3],e=state[4],f=state[5],g=state[6],h=state[7];
+#pragma GCC unroll 64
+	for (size_t t=0;t<64;++t)
+	{
+		if (t>=16)
+		{
+			__m256i w15=w[(t-15)%16];
+			__m256i w2=w[(t-2)%16];
+			__m256i s0=_mm256_xor_si256(_mm256_xor_si256(rotr8<7>(w15),rotr8<18>(w15)),_mm256_srli_epi32(w15,3));
+			__m256i s1=_mm256_xor_si256(_mm256_xor_si256(rotr8<17>(w2),rotr8<19>(w2)),_mm256_srli_epi32(w2,10));
+			w[t%16]=_mm256_add_epi32(_mm256_add_epi32(w[t%16],s0),_mm256_add_epi32(w[(t-7)%16],s1));
+		}
+		__m256i sum1=_mm256_xor_si256(_mm256_xor_si256(rotr8<6>(e),rotr8<11>(e)),rotr8<25>(e));
+		__m256i ch=_mm256_xor_si256(_mm256_and_si256(e,f),_mm256_andnot_si256(e,g));
+		__m256i t1=_mm256_add_epi32(_mm256_add_epi32(h,sum1),
+		                            _mm256_add_epi32(ch,_mm256_add_epi32(_mm256_set1_epi32(k256[t]),w[t%16])));
+		__m256i sum0=_mm256_xor_si256(_mm256_xor_si256(rotr8<2>(a),rotr8<13>(a)),rotr8<22>(a));
+		__m256i maj=_mm256_or_si256(_mm256_and_si256(a,b),_mm256_and_si256(c,_mm256_or_si256(a,b)));
+		__m256i t2=_mm256_add_epi32(sum0,maj);
+		h=g;
+		g=f;
+		f=e;
+		e=_mm256_add_epi32(d,t1);
+		d=c;
+		c=b;
+		b=a;
+		a=_mm256_add_epi32(t1,t2);
+	}
+	__m256i out[8]={a,b,c,d,e,f,g,h};
+	for (size_t i=0;i<8;++i)
+	{
+		state[i]=_mm256_blendv_epi8(state[i],_mm256_add_epi32(state[i],out[i]),active);
+	}
+}
+
+__attribute__((target("avx2")))
+void hash_avx2(Byte_view const* msgs, Byte_ptr const* digests, size_t count)
+{
+	static const Byte unused_block[block_size]={};
+	Message_blocks blocks[avx2_lanes];
+	for (size_t m=0;m<count;m+=avx2_lanes)
+	{
+		size_t n_lanes=std::min(avx2_lanes,count-m);
+		if (n_lanes==1)
+		{
+			hash_generic(msgs+m,digests+m,1);
+			break;
+		}
+		size_t n_blocks=0;
+		alignas(32) int32_t lane_blocks[avx2_lanes]={};
+		for (size_t l=0;l<n_lanes;++l)
+		{
+			blocks[l].set(msgs[m+l]);
+			lane_blocks[l]=static_cast<int32_t>(blocks[l].n_blocks);
+			n_blocks=std::max(n_blocks,blocks[l].n_blocks);
+		}
+		__m256i lane_blocks_v=_mm256_load_si256(reinterpret_cast<__m256i const*>(lane_blocks));
+		__m256i state[8];
+		for (size_t i=0;i<8;++i)
+		{
+			state[i]=_mm256_set1_epi32(static_cast<int32_t>(h256_initial[i]));
+		}
+		for (size_t b=0;b<n_blocks;++b)
+		{
+			Byte_const_ptr lane_block[avx2_lanes];
+			for (size_t l=0;l<avx2_lanes;++l)
+			{
+				lane_block[l]=(l<n_lanes && b<blocks[l].n_blocks)?blocks[l].block(b):unused_block;
+			}
+			__m256i active=_mm256_cmpgt_epi32(lane_blocks_v,_mm256_set1_epi32(static_cast<int32_t>(b)));
+			compress_avx2(state,lane_block,active);
+		}
+		alignas(32) uint32_t words[8][avx2_lanes];
+		for (size_t i=0;i<8;++i)
+		{
+			_mm256_store_si256(reinterpret_cast<__m256i*>(words[i]),state[i]);
+		}
+		for (size_t l=0;l<n_lanes;++l)
+		{
+			uint32_t lane_state[8];
+			for (size_t i=0;i<8;++i)
+			{
+				lane_state[i]=words[i][l];
+			}
+			store_digest(lane_state,digests[m+l]);
+		}
+	}
+}
+#endif
+}
+
+std::string sha256_engine_name(Sha256_engine engine)
+{
+	switch (engine)
+	{
+	case Sha256_engine::generic:
+		return "generic";
+	case Sha256_engine::sha_ni:
+		return "sha_ni";
+	case Sha256_engine::avx2:
+		return "avx2";
+	}
+	return "unknown";
+}
+
+bool sha256_engine_supported(Sha256_engine engine)
+{
+	switch (engine)
+	{
+	case Sha256_engine::generic:
+		return true;
+#ifdef SHA256_MULTI_X86
+	case Sha256_engine::sha_ni:
+		return cpu_has_sha_ni();
+	case Sha256_engine::avx2:
+		return cpu_has_avx2();
+#endif
+	default:
+		return false;
+	}
+}
+
+Sha256_engine sha256_best_engine()
+{
+	// Interleaved SHA extension rounds are faster than eight AVX2 lanes
+	static const Sha256_engine best=sha256_engine_supported(Sha256_engine::sha_ni)?Sha256_engine::sha_ni
+	                               :sha256_engine_supported(Sha256_engine::avx2)?Sha256_engine::avx2
+	                               :Sha256_engine::generic;
+	return best;
+}
+
+void sha256_multi(Byte_view const* msgs, Byte_ptr const* digests, size_t count)
+{
+	sha256_multi(msgs,digests,count,sha256_best_engine());
+}
+
+void sha256_multi(Byte_view const* msgs, Byte_ptr const* digests, size_t count, Sha256_engine engine)
+{
+	if (!sha256_engine_supported(engine))
+	{
+		throw(std::runtime_error("sha256_multi: the "+sha256_engine_name(engine)+" engine is not supported by this CPU"));
+	}
+	switch (engine)
+	{
+#ifdef SHA256_MULTI_X86
+	case Sha256_engine::sha_ni:
+		hash_sha_ni(msgs,digests,count);
+		break;
+	case Sha256_engine::avx2:
+		hash_avx2(msgs,digests,count);
+		break;
+#endif
+	default:
+		hash_generic(msgs,digests,count);
+		break;
+	}
+}
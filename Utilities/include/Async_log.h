@@ -0,0 +1,110 @@
+/*******************************************************************************
+* File:        Async_log.h
+* Description: A log that writes its records on a background thread
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Log_record.h"
+#include "Logging.h"
+
+// A log that queues records in a fixed-size ring and has its own thread
+// format them and write them to another log, the sink. The threads logging
+// do no formatting or I/O and take no locks: a record is copied into the
+// ring, or, if the ring is full, dropped and counted rather than making the
+// caller wait. Text written to os() or write_to_log is queued a line at a
+// time, each line in one record, so lines from different threads are never
+// mixed. A line longer than Log_record::data_size is cut short, with "..."
+// at the end, and flushing os() ends the line. Each line is given the time
+// it was logged, so the sink should be a log that does not add its own
+// (File_log or Cout_log).
+//
+// Logging must have stopped before the Async_log is destroyed, the
+// destructor writes out what is left in the ring.
+class Async_log : public Log
+{
+public:
+	static constexpr size_t default_capacity=4096;
+
+	Async_log()=delete;
+	// The capacity is rounded up to a power of 2
+	explicit Async_log(Log_ptr sink, size_t capacity=default_capacity);
+	Async_log(Async_log const&)=delete;
+	Async_log& operator=(Async_log const&)=delete;
+	virtual std::ostream& os();
+	virtual void write_to_log(std::string str);
+	virtual void write_record(Log_record const& record);
+	// Waits until the records queued so far have been written to the sink
+	void flush();
+	uint64_t dropped() const {return dropped_.load(std::memory_order_relaxed);}
+	virtual ~Async_log();
+
+private:
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		Log_record record;
+	};
+	static constexpr size_t max_batch=64;
+
+	bool try_push(Log_record const& record);
+	bool format_next(std::string& batch);
+	void drain();
+
+	Log_ptr sink_;
+	size_t mask_;
+	std::unique_ptr<Slot[]> slots_;
+	std::atomic<size_t> head_;          // The next slot to fill
+	std::atomic<uint64_t> dropped_;
+	std::atomic<bool> waiting_;         // The drain thread is waiting
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable flushed_;
+	bool stopping_;                     // These are guarded by mutex_
+	size_t written_;
+	size_t tail_;                       // Only used by the drain thread
+	int64_t time_seconds_;              // The time last formatted, to reuse
+	std::string time_text_;
+	std::thread thread_;
+};
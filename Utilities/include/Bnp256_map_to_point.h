@@ -0,0 +1,65 @@
+/*******************************************************************************
+* File:        Bnp256_map_to_point.h
+* Description: Map-to-point for BN_P256 using fixed-width AMCL field arithmetic
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once 
+
+#include <cstdint>
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+
+// The same try-and-increment mapping as map_to_point (and TPM2_Commit):
+// s_2=counter+initial_value, x_2=sha256(s_2) mod p. Candidates whose
+// right-hand side is not a square are rejected with the Jacobi symbol, so
+// a square root, (x^3+b)^((p+1)/4) as p=3 mod 4, is only taken once.
+// Returns (s_2,y_2) with y_2 encoded as by BN_bn2bin, bit-for-bit the
+// same as map_to_point(bnp256_ec_group(),initial_value,max_iter).
+// Basenames are public, so the rejection test need not be constant time.
+G1_point bnp256_map_to_point(
+Byte_buffer const& initial_value,
+uint32_t max_iter
+);
+
+// Maps each of the initial values in turn, sharing the curve constants
+// and working storage across the whole batch
+std::vector<G1_point> bnp256_map_to_points(
+std::vector<Byte_buffer> const& initial_values,
+uint32_t max_iter
+);
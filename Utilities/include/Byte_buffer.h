@@ -52,52 +52,93 @@ using Byte_const_ptr=Byte const*;
 const unsigned int hex_base{16};
 const unsigned int byte_base{256};
 
+class Byte_buffer;
+
+// A non-owning view of part of a Byte_buffer (or of any other bytes). The
+// bytes must outlive the view and a view into a Byte_buffer is invalidated
+// by anything that changes the buffer's size.
+class Byte_view
+{
+public:
+	Byte_view() : data_(nullptr), size_(0) {}
+	Byte_view(Byte_const_ptr data, size_t size) : data_(data), size_(size) {}
+	Byte_view(Byte_buffer const& bb);
+	Byte const& operator[](size_t pos) const { return data_[pos]; }
+	Byte_const_ptr data() const {return data_;}
+	size_t size() const {return size_;}
+	bool empty() const {return size_==0;}
+	Byte_view subview(size_t start, size_t length) const;
+
+private:
+	Byte_const_ptr data_;
+	size_t size_;
+};
+
+bool operator==(Byte_view lhs, Byte_view rhs);
+inline bool operator!=(Byte_view lhs, Byte_view rhs) {return !(lhs==rhs);}
+
+// The bytes are held in the object itself, without an allocation, up to
+// inline_capacity bytes (enough for an uncompressed G1 point or three hashes)
 class Byte_buffer
 {
 public:
 	using Bytes = std::vector<Byte>;
-	static const uint32_t initial_reserved_size=32;
-	static const size_t data_start=2;
-	Byte_buffer();
-	Byte_buffer(Byte_buffer const& bb)=default;
-	Byte_buffer(Byte_buffer&& bb)=default;
-	Byte_buffer& operator=(Byte_buffer const& bb)=default;
+	static const size_t inline_capacity=96;
+	Byte_buffer() : data_(inline_), size_(0), capacity_(inline_capacity) {}
+	Byte_buffer(Byte_buffer const& bb);
+	Byte_buffer(Byte_buffer&& bb) noexcept;
+	Byte_buffer& operator=(Byte_buffer const& bb);
+	Byte_buffer& operator=(Byte_buffer&& bb) noexcept;
 	Byte_buffer(std::initializer_list<Byte> il);
 	Byte_buffer(size_t sz, Byte b);
 	explicit Byte_buffer(std::string const& str);	// Each character is one Byte 
 	explicit Byte_buffer(Hex_string const & hs);	// Every two hex characters are one Byte
 	Byte_buffer(const Byte* buf, size_t len);
-	explicit Byte_buffer(Bytes bv);
-	Byte& operator[](size_t pos) { return byte_buf_[pos]; }
-	Byte const& operator[](size_t pos) const { return byte_buf_[pos]; }
+	explicit Byte_buffer(Bytes const& bv);
+	explicit Byte_buffer(Byte_view bv);
+	Byte& operator[](size_t pos) { return data_[pos]; }
+	Byte const& operator[](size_t pos) const { return data_[pos]; }
 	Byte_buffer get_part(size_t start, size_t length) const;
+	// As get_part, without copying
+	Byte_view view(size_t start, size_t length) const;
 	void set_part(size_t start, Byte_buffer const& part);
-	Byte_buffer& operator+=(Byte_buffer const& b);
-	bool operator==(Byte_buffer const& rhs) const {return byte_buf_==rhs.byte_buf_;}
-	bool operator!=(Byte_buffer const& rhs) const {return byte_buf_!=rhs.byte_buf_;}
-	bool operator<(Byte_buffer const& rhs) const {return byte_buf_<rhs.byte_buf_;}
-	void resize(size_t n) { byte_buf_.resize(n); }
-	void reserve(size_t n) { byte_buf_.reserve(n); }
-	void push_back(Byte b) {byte_buf_.push_back(b);}
-        Byte_ptr data() {return byte_buf_.data();}
-        Byte_const_ptr cdata() const {return byte_buf_.data();}
-	size_t size() const {return byte_buf_.size();}
+	void append(Byte_const_ptr buf, size_t len);
+	void append(Byte_view bv) {append(bv.data(),bv.size());}
+	Byte_buffer& operator+=(Byte_buffer const& b) {append(b.data_,b.size_); return *this;}
+	bool operator==(Byte_buffer const& rhs) const {return Byte_view(*this)==Byte_view(rhs);}
+	bool operator!=(Byte_buffer const& rhs) const {return !(*this==rhs);}
+	bool operator<(Byte_buffer const& rhs) const;
+	void resize(size_t n);
+	void reserve(size_t n);
+	void push_back(Byte b) {if (size_==capacity_) grow(size_+1); data_[size_++]=b;}
+        Byte_ptr data() {return data_;}
+        Byte_const_ptr cdata() const {return data_;}
+	size_t size() const {return size_;}
 	void pad_right(size_t new_length, Byte b=0);
 	void pad_left(size_t new_length, Byte b=0);
 	void truncate();
-	void clear() { byte_buf_.clear(); }
+	void clear() { size_=0; }
 	std::string to_hex_string() const;
     friend std::istream& operator>>(std::istream& is, Byte_buffer& bb);
-	~Byte_buffer()=default;
+	~Byte_buffer() {release();}
 
 private:	
-	Bytes byte_buf_;
+	Byte_ptr data_;			// inline_ or an allocation
+	size_t size_;
+	size_t capacity_;
+	Byte inline_[inline_capacity];
 
-	void initialise();
+	void grow(size_t min_capacity);
+	void release() {if (data_!=inline_) delete[] data_;}
 };
 
+inline Byte_view::Byte_view(Byte_buffer const& bb) : data_(bb.cdata()), size_(bb.size()) {}
+
 Byte_buffer operator+(Byte_buffer const& a, Byte_buffer const& b);
 
+// Appends to a, so that a chain a+b+c+... only copies the first operand once
+Byte_buffer operator+(Byte_buffer&& a, Byte_buffer const& b);
+
 // Reads a Byte_buffer from the input stream. The input should be an even number of hex characters
 // terminated with whitespace NOT just with some non-hex character
 std::istream& operator>>(std::istream& is, Byte_buffer& bb);
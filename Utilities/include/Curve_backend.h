@@ -0,0 +1,97 @@
+/*******************************************************************************
+* File:        Curve_backend.h
+* Description: The curve library used for the DAA calculations, chosen at compile time
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+#include "Byte_buffer.h"
+#include "Openssl_g1.h"
+#include "Amcl_utils.h"
+#include "G1_ecp.h"
+#include "G1_fixed_base.h"
+
+// A curve backend provides the types and the few operations that the DAA
+// code uses:
+//  Scalar      - an integer mod the group order
+//  G1          - a point in G1, constructed from a G1_point, with +, -, [k]P
+//                and to_g1_point()
+//  G1_prepared - a point that is multiplied repeatedly, mul(k) is [k]P
+//  G2, GT      - the pairing groups
+//  generator_mul(k) - [k]P_1
+//  multi_mul(k,P)   - [k_1]P_1+...+[k_n]P_n, for public values only
+//  batch_to_g1_points(P) - to_g1_point() for each point, sharing the field
+//                   inversion where the backend can
+// Both backends give the same encodings from to_g1_point(), so the hashes of
+// the points agree. OpenSSL has no pairings, so G2 and GT are always AMCL's.
+
+struct Amcl_curve
+{
+	using Scalar=Byte_buffer;
+	using G1=G1_ecp;
+	using G1_prepared=G1_prepared_point;
+	using G2=ECP2;
+	using GT=FP12;
+	static const char* name() {return "AMCL";}
+	static G1 generator_mul(Scalar const& k) {return g1_generator_table().mul(k);}
+	static G1 multi_mul(std::vector<Scalar> const& k, std::vector<G1> const& pts) {return ec_multi_mul(k,pts);}
+	static std::vector<G1_point> batch_to_g1_points(std::vector<G1> const& pts) {return g1_batch_to_g1_points(pts);}
+};
+
+struct Openssl_curve
+{
+	using Scalar=Byte_buffer;
+	using G1=Openssl_g1;
+	using G1_prepared=Openssl_prepared_point;
+	using G2=ECP2;
+	using GT=FP12;
+	static const char* name() {return "OpenSSL";}
+	static G1 generator_mul(Scalar const& k) {return openssl_generator_mul(k);}
+	static G1 multi_mul(std::vector<Scalar> const& k, std::vector<G1> const& pts) {return openssl_multi_mul(k,pts);}
+	static std::vector<G1_point> batch_to_g1_points(std::vector<G1> const& pts) {return openssl_batch_to_g1_points(pts);}
+};
+
+// Build with CURVE_BACKEND=openssl (which defines CURVE_BACKEND_OPENSSL) to
+// use OpenSSL for G1, the default is AMCL
+#ifdef CURVE_BACKEND_OPENSSL
+using Curve=Openssl_curve;
+#else
+using Curve=Amcl_curve;
+#endif
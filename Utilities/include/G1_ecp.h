@@ -0,0 +1,106 @@
+/*******************************************************************************
+* File:        G1_ecp.h
+* Description: A point in G1 held in AMCL's internal form for calculations
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Amcl_utils.h"
+
+// A point in G1 kept in AMCL's internal (projective) form. A sequence of
+// calculations can then be done without converting to and from bytes, this
+// is only needed when points are hashed, or written out.
+class G1_ecp
+{
+public:
+	G1_ecp();                               // The point at infinity
+	explicit G1_ecp(G1_point const& pt);    // Throws if pt is not on the curve
+	G1_ecp(G1_ecp const& pt)=default;
+	G1_ecp& operator=(G1_ecp const& pt)=default;
+	static G1_ecp generator();
+	bool is_infinity() const;
+	bool operator==(G1_ecp const& rhs) const;
+	bool operator!=(G1_ecp const& rhs) const {return !(*this==rhs);}
+	G1_ecp& operator+=(G1_ecp const& rhs);
+	G1_ecp& operator-=(G1_ecp const& rhs);
+	G1_ecp operator-() const;
+	// Multiplies by k (mod the group order)
+	G1_ecp& operator*=(Byte_buffer const& k);
+	// The affine coordinates, in the same form as point2bb. Throws for the
+	// point at infinity.
+	G1_point to_g1_point() const;
+	ECP* ecp() {return &pt_;}
+	ECP const* ecp() const {return &pt_;}
+	~G1_ecp()=default;
+
+private:
+	ECP pt_;
+};
+
+G1_ecp operator+(G1_ecp a, G1_ecp const& b);
+
+G1_ecp operator-(G1_ecp a, G1_ecp const& b);
+
+G1_ecp operator*(Byte_buffer const& k, G1_ecp pt);
+
+// Converts the points to affine form (Z=1) with a single field inversion
+// (Montgomery's trick), instead of one inversion for each point. Points at
+// infinity are left as they are. Note that operator*= (PAIR_G1mul) already
+// returns an affine point, G1_fixed_base and G1_prepared_point do not.
+void g1_batch_normalise(std::vector<G1_ecp>& pts);
+
+// to_g1_point() for each point, using g1_batch_normalise. Throws if any of
+// the points is the point at infinity.
+std::vector<G1_point> g1_batch_to_g1_points(std::vector<G1_ecp> pts);
+
+// The scalar as an AMCL BIG reduced mod the group order
+void scalar_to_big(Byte_buffer const& k, BIG& n);
+
+// Splits e into u_0+u_1.lambda mod the group order, where [lambda]P is
+// (cru.x,y). Both parts are about half the size of the order.
+void glv_split(BIG e, BIG u[2]);
+
+// Calculates [k_1]P_1+...+[k_n]P_n with a single chain of doublings (Straus'
+// method). Each scalar is split in two with the GLV endomorphism and recoded
+// to width-4 NAF, so two terms cost little more than one multiplication.
+// This is not constant time and must only be used with public values.
+G1_ecp ec_multi_mul(std::vector<Byte_buffer> const& scalars, std::vector<G1_ecp> const& points);
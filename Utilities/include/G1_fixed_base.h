@@ -0,0 +1,85 @@
+/*******************************************************************************
+* File:        G1_fixed_base.h
+* Description: Multiplication of fixed points in G1 using precomputed tables
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+#include "Byte_buffer.h"
+#include "G1_ecp.h"
+
+// Odd multiples 1,3,...,15 of a point are stored for signed radix-16 digits
+const size_t g1_odd_multiples=8;
+
+// Multiplication of a fixed point by secret scalars. Rows of odd multiples
+// of 16^i.P are calculated once, so a multiplication needs no doublings,
+// just one addition for each 4 bits of the scalar. The table entries are
+// read in constant time.
+class G1_fixed_base
+{
+public:
+	explicit G1_fixed_base(G1_ecp const& base);
+	G1_ecp mul(Byte_buffer const& k) const;
+	~G1_fixed_base()=default;
+
+private:
+	ECP base_;
+	ECP twice_base_;
+	std::vector<ECP> table_;	// Row i holds (2j+1).16^i.P, j=0..7
+};
+
+// The table for the generator P_1, calculated when first used
+G1_fixed_base const& g1_generator_table();
+
+// A point that is multiplied by a few secret scalars, e.g. the applicant's
+// DAA key during a join. The odd multiples of the point and its image under
+// the GLV endomorphism are calculated once, and each multiplication then
+// needs about half the doublings of a full length scalar. As for
+// G1_fixed_base, the steps taken do not depend on the scalar.
+class G1_prepared_point
+{
+public:
+	explicit G1_prepared_point(G1_ecp const& pt);
+	G1_ecp mul(Byte_buffer const& k) const;
+	~G1_prepared_point()=default;
+
+private:
+	ECP table_[2][g1_odd_multiples];	// (2j+1).P and (2j+1).phi(P)
+};
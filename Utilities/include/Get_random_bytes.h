@@ -40,24 +40,49 @@
 
 #pragma once
 
-#include <random>
+#include <cstdint>
 #include "Byte_buffer.h"
 
+// A ChaCha20 generator using fast key erasure: each refill of the buffer
+// makes a new key from the start of the key stream, and bytes are erased
+// from the buffer as they are used, so a later copy of the state does not
+// give away earlier output. It is seeded from getrandom, unless a non-zero
+// seed is given, when the output is the same each time - for tests and
+// benchmarks only. The generator is not thread safe, each thread should have
+// its own (see thread_random_generator). One seeded from getrandom reseeds
+// itself after a fork.
 class Random_byte_generator
 {
 public:
-    explicit Random_byte_generator(unsigned int seed=0);
-    Byte_buffer operator()(size_t number_of_bytes);
+	explicit Random_byte_generator(uint64_t seed=0);
+	Random_byte_generator(Random_byte_generator const&)=delete;
+	Random_byte_generator& operator=(Random_byte_generator const&)=delete;
+	~Random_byte_generator();
+	Byte_buffer operator()(size_t number_of_bytes);
+	void fill(Byte_ptr out, size_t len);
+
+	static constexpr size_t key_words=8;
+	static constexpr size_t block_size=64;
+	static constexpr size_t buffer_blocks=8;
 
 private:
-	// Use the C++ PRNG for now
-    std::default_random_engine dre;
-	std::uniform_int_distribution<short> rb;
+	void refill();
+	void reseed();
+	uint32_t key_[key_words];
+	Byte buffer_[buffer_blocks*block_size];
+	size_t used_;               // Bytes of the buffer already used
+	bool fixed_seed_;
+	unsigned int forks_seen_;   // To tell when it is in a new child process
 };
 
+// This thread's generator, seeded from getrandom
+Random_byte_generator& thread_random_generator();
+
+// Fills the buffer from getrandom, throws if that fails
+void get_system_random_bytes(Byte_ptr out, size_t len);
 
+// Bytes from a generator with the given seed, or from getrandom if it is 0
 Byte_buffer get_random_bytes(
 size_t number_of_bytes,
 unsigned int seed
 );
-
@@ -0,0 +1,165 @@
+/*******************************************************************************
+* File:        Log_record.h
+* Description: Fixed-size log records, formatted when they are written out
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "Byte_buffer.h"
+
+// A log statement's format and arguments, kept as values so that the
+// formatting (hex strings, number conversion) can be done later, on another
+// thread. Each "{}" in the format is replaced by the next argument. The
+// format must be a string literal, as only the pointer is kept. Strings and
+// byte buffers are copied into the record, and are cut short if they do not
+// fit, with "..." at the end of the line. A record with no format is a line
+// of text.
+struct Log_record
+{
+	enum class Arg_type : uint8_t {signed_int, unsigned_int, floating, text, bytes};
+	union Arg_value
+	{
+		int64_t i;
+		uint64_t u;
+		double d;
+		struct {uint16_t offset; uint16_t size;} span;
+	};
+	static constexpr size_t max_args=8;
+	static constexpr size_t data_size=160;
+
+	Log_record() : time(0), format(nullptr), data_used(0), n_args(0), truncated(false) {}
+
+	int64_t time;           // system_clock ticks when it was made
+	char const* format;
+	uint16_t data_used;
+	uint8_t n_args;
+	bool truncated;
+	Arg_type types[max_args];
+	Arg_value values[max_args];
+	char data[data_size];
+
+	// Copies what will fit of the bytes into data, returns the number copied
+	size_t append_data(void const* p, size_t size)
+	{
+		size_t n=(size<data_size-data_used)?size:data_size-data_used;
+		std::memcpy(data+data_used,p,n);
+		data_used+=n;
+		truncated|=(n<size);
+		return n;
+	}
+};
+
+static_assert(sizeof(Log_record)==256,"Log_record should be 256 bytes");
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+append_log_arg(Log_record& r, T v)
+{
+	r.types[r.n_args]=Log_record::Arg_type::signed_int;
+	r.values[r.n_args++].i=v;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type
+append_log_arg(Log_record& r, T v)
+{
+	r.types[r.n_args]=Log_record::Arg_type::unsigned_int;
+	r.values[r.n_args++].u=v;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+append_log_arg(Log_record& r, T v)
+{
+	r.types[r.n_args]=Log_record::Arg_type::floating;
+	r.values[r.n_args++].d=v;
+}
+
+inline void append_log_span(Log_record& r, Log_record::Arg_type type, void const* p, size_t size)
+{
+	r.types[r.n_args]=type;
+	r.values[r.n_args].span.offset=r.data_used;
+	r.values[r.n_args++].span.size=static_cast<uint16_t>(r.append_data(p,size));
+}
+
+inline void append_log_arg(Log_record& r, char const* s)
+{
+	append_log_span(r,Log_record::Arg_type::text,s,std::strlen(s));
+}
+
+inline void append_log_arg(Log_record& r, std::string const& s)
+{
+	append_log_span(r,Log_record::Arg_type::text,s.data(),s.size());
+}
+
+// Written as a hex string
+inline void append_log_arg(Log_record& r, Byte_buffer const& bb)
+{
+	append_log_span(r,Log_record::Arg_type::bytes,bb.cdata(),bb.size());
+}
+
+// A record of the format and (at most max_args) arguments, with the time now
+template <typename... Args>
+Log_record make_log_record(char const* format, Args const&... args)
+{
+	static_assert(sizeof...(Args)<=Log_record::max_args,"Too many arguments for a log record");
+	Log_record r;
+	r.time=std::chrono::system_clock::now().time_since_epoch().count();
+	r.format=format;
+	int unused[]={0,(append_log_arg(r,args),0)...};
+	(void)unused;
+	return r;
+}
+
+// A record holding a line of text, without its newline. Text after the first
+// data_size characters is cut off.
+void make_text_record(Log_record& r, char const* text, size_t size);
+
+// The record's text, without a time stamp
+std::string format_log_record(Log_record const& r);
+
+// As format_log_record, adding the text to the end of str
+void append_log_record(std::string& str, Log_record const& r);
+
+// The time the record was made, as time_point_to_string gives it
+std::string log_record_time(Log_record const& r);
@@ -43,6 +43,7 @@
 #include <fstream>
 #include <string>
 #include <memory>
+#include "Log_record.h"
 
 class Log;
 using Log_ptr=std::unique_ptr<Log>;
@@ -85,17 +86,41 @@ public:
 	virtual void write_to_log(std::string str)=0;
 	void set_debug_level(uint dl) {debug_=dl;}
 	uint  debug_level() const {return debug_;}
+	// Formats the record and writes it with write_to_log
+	virtual void write_record(Log_record const& record);
 	virtual ~Log()=default;
 
 private:
 	uint debug_;
 };
 
+// LOG_DEBUG statements for debug levels above this are removed when
+// compiling, arguments and all, e.g. -DLOG_MAX_DEBUG_LEVEL=0 for a release
+// build
+#ifndef LOG_MAX_DEBUG_LEVEL
+#define LOG_MAX_DEBUG_LEVEL 255
+#endif
+
+// Logs, if the debug level is at least level, a format and its arguments
+// (see Log_record.h). Nothing is formatted here, the arguments are copied
+// into a record for the log to format, so an Async_log does it on its own
+// thread, e.g.
+//     LOG_DEBUG(1,"Signature {} failed, K: {}",i,k.first);
+#define LOG_DEBUG(level,...) \
+	do \
+	{ \
+		if ((level)<=LOG_MAX_DEBUG_LEVEL && log_ptr->debug_level()>=(level)) \
+		{ \
+			log_ptr->write_record(make_log_record(__VA_ARGS__)); \
+		} \
+	} while (0)
+
 class Null_log : public Log
 {
 public:	
 	virtual std::ostream& os() {return null_stream_;}
 	virtual void write_to_log(std::string str){}
+	virtual void write_record(Log_record const& record) {}
 	virtual ~Null_log() throw()=default;
 private:
     Null_stream null_stream_;
@@ -55,6 +55,10 @@ Bn_ctx_ptr new_bn_ctx();
 using Bn_ptr=std::unique_ptr<BIGNUM,decltype(&::BN_free)>;
 Bn_ptr new_bn();
 
+// A BN_CTX for the calling thread, created on first use and kept for the
+// life of the thread. It must not be freed.
+BN_CTX* thread_bn_ctx();
+
 Byte_buffer bb_mod(Byte_buffer const& num,Byte_buffer const& modulus);
 
 Byte_buffer bb_add(Byte_buffer const& a,Byte_buffer const& b);
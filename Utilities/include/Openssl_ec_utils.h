@@ -55,6 +55,11 @@
 using Ec_group_ptr=std::unique_ptr<EC_GROUP,decltype(&::EC_GROUP_free)>;
 Ec_group_ptr new_ec_group(std::string const& curve_name);
 
+// The BN_P256 curve, built and checked once with the generator multiples
+// precomputed. It is shared, so must not be changed. new_ec_group("bnp256")
+// returns a copy of this.
+Ec_group_ptr const& bnp256_ec_group();
+
 using Ec_key_ptr=std::unique_ptr<EC_KEY,decltype(&::EC_KEY_free)>;
 Ec_key_ptr new_ec_key();
 
@@ -0,0 +1,103 @@
+/*******************************************************************************
+* File:        Openssl_g1.h
+* Description: A G1 point type using OpenSSL, with the same interface as G1_ecp
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+#include <openssl/ec.h>
+#include "Byte_buffer.h"
+#include "G1_utils.h"
+#include "Openssl_ec_utils.h"
+
+// A point on BN_P256 held as an OpenSSL EC_POINT. This has the same
+// interface as G1_ecp so that either can be used as the G1 type of a curve
+// backend (see Curve_backend.h).
+class Openssl_g1
+{
+public:
+	Openssl_g1();                                   // The point at infinity
+	explicit Openssl_g1(G1_point const& pt);        // Throws if pt is not on the curve
+	Openssl_g1(Openssl_g1 const& pt);
+	Openssl_g1& operator=(Openssl_g1 const& pt);
+	static Openssl_g1 generator();
+	bool is_infinity() const;
+	bool operator==(Openssl_g1 const& rhs) const;
+	bool operator!=(Openssl_g1 const& rhs) const {return !(*this==rhs);}
+	Openssl_g1& operator+=(Openssl_g1 const& rhs);
+	Openssl_g1& operator-=(Openssl_g1 const& rhs);
+	Openssl_g1 operator-() const;
+	Openssl_g1& operator*=(Byte_buffer const& k);
+	// The affine coordinates, as point2bb. Throws for the point at infinity.
+	G1_point to_g1_point() const;
+	EC_POINT* point() {return pt_.get();}
+	EC_POINT const* point() const {return pt_.get();}
+	~Openssl_g1()=default;
+
+private:
+	Ec_point_ptr pt_;
+};
+
+Openssl_g1 operator+(Openssl_g1 a, Openssl_g1 const& b);
+
+Openssl_g1 operator-(Openssl_g1 a, Openssl_g1 const& b);
+
+Openssl_g1 operator*(Byte_buffer const& k, Openssl_g1 pt);
+
+// [k]P_1, using the generator multiples precomputed for bnp256_ec_group()
+Openssl_g1 openssl_generator_mul(Byte_buffer const& k);
+
+// [k_1]P_1+...+[k_n]P_n
+Openssl_g1 openssl_multi_mul(std::vector<Byte_buffer> const& scalars, std::vector<Openssl_g1> const& points);
+
+// to_g1_point() for each point. OpenSSL 3 only has a batch conversion in its
+// deprecated API (EC_POINTs_make_affine), so this is one inversion per point.
+std::vector<G1_point> openssl_batch_to_g1_points(std::vector<Openssl_g1> const& pts);
+
+// A point that is multiplied repeatedly, OpenSSL does its own precomputation
+// so this just keeps the point
+class Openssl_prepared_point
+{
+public:
+	explicit Openssl_prepared_point(Openssl_g1 const& pt) : pt_(pt) {}
+	Openssl_g1 mul(Byte_buffer const& k) const {return k*pt_;}
+private:
+	Openssl_g1 pt_;
+};
@@ -0,0 +1,99 @@
+/*******************************************************************************
+* File:        Scalar_bnp256.h
+* Description: Integers mod the order of the BN_P256 group, without heap allocation
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "Byte_buffer.h"
+
+class Random_byte_generator;
+
+// An integer mod n, the order of the BN_P256 group, held in eight 32-bit limbs
+// (so it is the same on the 32-bit Raspberry Pi). Multiplication uses
+// Montgomery reduction. None of the arithmetic allocates, only
+// to_byte_buffer() does.
+class Scalar_bnp256
+{
+public:
+	static constexpr size_t n_limbs=8;
+	static constexpr size_t n_bytes=32;
+
+	Scalar_bnp256() : v_{} {}   // Zero
+	// Reduces a big-endian number of any length mod n, e.g. a SHA-256 digest
+	// or random bytes
+	explicit Scalar_bnp256(Byte_buffer const& bb);
+	Scalar_bnp256(uint8_t const* bytes, size_t size);
+	bool is_zero() const;
+	bool operator==(Scalar_bnp256 const& rhs) const;
+	bool operator!=(Scalar_bnp256 const& rhs) const {return !(*this==rhs);}
+	Scalar_bnp256& operator+=(Scalar_bnp256 const& rhs);
+	Scalar_bnp256& operator-=(Scalar_bnp256 const& rhs);
+	Scalar_bnp256& operator*=(Scalar_bnp256 const& rhs);
+	Scalar_bnp256 operator-() const;
+	// Big-endian, 32 bytes
+	void to_bytes(uint8_t* out) const;
+	// Big-endian without leading zeros, as bb_mod returns
+	Byte_buffer to_byte_buffer() const;
+
+private:
+	using Limbs=std::array<uint32_t,n_limbs>;
+	Limbs v_;     // Least significant limb first, always less than n
+};
+
+inline Scalar_bnp256 operator+(Scalar_bnp256 a, Scalar_bnp256 const& b) {return a+=b;}
+
+inline Scalar_bnp256 operator-(Scalar_bnp256 a, Scalar_bnp256 const& b) {return a-=b;}
+
+inline Scalar_bnp256 operator*(Scalar_bnp256 a, Scalar_bnp256 const& b) {return a*=b;}
+
+// H(bb) mod n, with H SHA-256
+Scalar_bnp256 hash_to_scalar(Byte_buffer const& bb);
+
+// A random non-zero value mod n. It is 48 random bytes reduced mod n, so the
+// bias is below 2^-128 and there is no rejection loop (zero, the only value
+// redrawn, has probability about 2^-256)
+Scalar_bnp256 random_scalar_mod_n(Random_byte_generator& rbg);
+
+// As above, from this thread's generator
+Scalar_bnp256 random_scalar_mod_n();
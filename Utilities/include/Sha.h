@@ -42,4 +42,40 @@
 
 #include "Byte_buffer.h"
 
+const size_t sha256_digest_size=32;
+
+// Not including the OpenSSL headers here avoids the clash between their
+// SHA256 and AMCL's
+struct evp_md_ctx_st;
+
+// Hashes data as it is added, so that it need not be concatenated first.
+// The OpenSSL contexts are kept on a list for each thread and reused, so once
+// a thread has used a hasher no more are allocated. Small updates are
+// collected and passed on together, as each call into OpenSSL costs about as
+// much as hashing a coordinate.
+class Sha256_hasher
+{
+public:
+	Sha256_hasher();
+	Sha256_hasher(Sha256_hasher const&)=delete;
+	Sha256_hasher& operator=(Sha256_hasher const&)=delete;
+	~Sha256_hasher();
+	Sha256_hasher& update(Byte_const_ptr data, size_t len);
+	Sha256_hasher& update(Byte_view bv) {return update(bv.data(),bv.size());}
+	// Adds the value padded on the left with zeros to length bytes, as
+	// pad_left would. Throws if the value is longer than that.
+	Sha256_hasher& update_padded(Byte_view bv, size_t length);
+	// Writes sha256_digest_size bytes. Anything added after this starts a
+	// new hash.
+	void finish(Byte_ptr digest);
+	Byte_buffer finish();
+
+private:
+	void flush();
+	evp_md_ctx_st* ctx_;
+	bool finished_;
+	size_t pending_size_;
+	Byte pending_[256];
+};
+
 Byte_buffer sha256_bb(Byte_buffer const& bb);
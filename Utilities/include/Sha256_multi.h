@@ -0,0 +1,71 @@
+/*******************************************************************************
+* File:        Sha256_multi.h
+* Description: SHA-256 of several independent messages at once
+*
+* Author:      Chris Newton
+* Created:     Saturday 17 October 2026
+*
+* (C) Copyright 2026, University of Surrey.
+*
+*******************************************************************************/
+
+/*******************************************************************************
+*                                                                              *
+* (C) Copyright 2019 University of Surrey                                      *
+*                                                                              *
+* Redistribution and use in source and binary forms, with or without           *
+* modification, are permitted provided that the following conditions are met:  *
+*                                                                              *
+* 1. Redistributions of source code must retain the above copyright notice,    *
+* this list of conditions and the following disclaimer.                        *
+*                                                                              *
+* 2. Redistributions in binary form must reproduce the above copyright notice, *
+* this list of conditions and the following disclaimer in the documentation    *
+* and/or other materials provided with the distribution.                       *
+*                                                                              *
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"  *
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE    *
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE   *
+* ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE    *
+* LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR          *
+* CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF         *
+* SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS     *
+* INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN      *
+* CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)      *
+* ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE   *
+* POSSIBILITY OF SUCH DAMAGE.                                                  *
+*                                                                              *
+*******************************************************************************/
+
+
+#pragma once
+
+#include <string>
+#include "Byte_buffer.h"
+#include "Sha.h"
+
+// The ways several messages can be hashed at once:
+//   generic - one message at a time, in portable code
+//   sha_ni  - the x86 SHA extensions, two messages interleaved so that each
+//             hides the latency of the other
+//   avx2    - eight messages, one in each 32 bit lane of the AVX2 registers
+enum class Sha256_engine
+{
+	generic,
+	sha_ni,
+	avx2
+};
+
+std::string sha256_engine_name(Sha256_engine engine);
+
+bool sha256_engine_supported(Sha256_engine engine);
+
+// The fastest engine this CPU supports, checked once
+Sha256_engine sha256_best_engine();
+
+// Hashes count messages, writing sha256_digest_size bytes to each of digests.
+// The messages need not be the same length.
+void sha256_multi(Byte_view const* msgs, Byte_ptr const* digests, size_t count);
+
+// As above, using the given engine. Throws if the CPU does not support it.
+void sha256_multi(Byte_view const* msgs, Byte_ptr const* digests, size_t count, Sha256_engine engine);